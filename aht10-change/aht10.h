@@ -1,84 +1,141 @@
-/*
- * Copyright (c) 2006-2018, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2018-08-15     Ernest Chen  the first version
- */
- 
-#ifndef __AHT10_H__
-#define __AHT10_H__
-
-#include <rthw.h>
-#include <rtthread.h>
-
-#include <rthw.h>
-#include <rtdevice.h>
-
-#ifdef AHT10_USING_SOFT_FILTER
-
-typedef struct filter_data
-{
-    float buf[AHT10_AVERAGE_TIMES];
-    float average;
-
-    rt_off_t index;
-    rt_bool_t is_full;
-
-} filter_data_t;
-#endif /* AHT10_USING_SOFT_FILTER */
-
-struct aht10_device
-{
-    struct rt_i2c_bus_device *i2c;
- //   struct rt_i2c_bus_device* i2c2;
-
-#ifdef AHT10_USING_SOFT_FILTER
-    filter_data_t temp_filter;
-    filter_data_t humi_filter;
-
-    rt_thread_t thread;
-    rt_uint32_t period; //sample period
-#endif /* AHT10_USING_SOFT_FILTER */
-
-    rt_mutex_t lock;
-};
-typedef struct aht10_device *aht10_device_t;
-
-/**
- * This function initializes aht10 registered device driver
- *
- * @param dev the name of aht10 device
- *
- * @return the aht10 device.
- */
-aht10_device_t aht10_init(const char *i2c_bus_name);
-
-/**
- * This function releases memory and deletes mutex lock
- *
- * @param dev the pointer of device driver structure
- */
-void aht10_deinit(aht10_device_t dev);
-
-/**
- * This function reads temperature by aht10 sensor measurement
- *
- * @param dev the pointer of device driver structure
- *
- * @return the relative temperature converted to float data.
- */
-float aht10_read_temperature(aht10_device_t dev);
-
-/**
- * This function reads relative humidity by aht10 sensor measurement
- *
- * @param dev the pointer of device driver structure
- *
- * @return the relative humidity converted to float data.
- */
-float aht10_read_humidity(aht10_device_t dev);
-
-#endif /* __DRV_AHT10_H__ */
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2018-08-15     Ernest Chen  the first version
+ */
+ 
+#ifndef __AHT10_H__
+#define __AHT10_H__
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#include <rthw.h>
+#include <rtdevice.h>
+
+#define AHT10_MEASURE_MS 80        //a measurement takes 75 ms
+
+#ifdef AHT10_USING_SOFT_FILTER
+
+/* Values in 0.1 units, the dCelsius or permillage of aht10_read_x10 */
+typedef struct filter_data
+{
+    rt_int32_t buf[AHT10_AVERAGE_TIMES];
+    rt_int32_t average;
+
+    rt_off_t index;
+    rt_bool_t is_full;
+
+} filter_data_t;
+#endif /* AHT10_USING_SOFT_FILTER */
+
+struct aht10_device
+{
+    struct rt_i2c_bus_device *i2c;
+ //   struct rt_i2c_bus_device* i2c2;
+
+#ifdef AHT10_USING_SOFT_FILTER
+    filter_data_t temp_filter;
+    filter_data_t humi_filter;
+#endif /* AHT10_USING_SOFT_FILTER */
+
+    rt_bool_t measured;     /* A measurement was triggered, a read returns its result */
+    rt_mutex_t lock;
+};
+typedef struct aht10_device *aht10_device_t;
+
+/*
+ * Integer conversion of the 20-bit results to the sensor framework units,
+ * rounded to nearest:
+ *   T  = raw * 200 / 2^20 - 50   ->  dCelsius    = raw * 2000 / 2^20 - 500
+ *   RH = raw * 100 / 2^20        ->  permillage  = raw * 1000 / 2^20
+ * raw * 2000 stays below 2^31, so 32-bit arithmetic is exact.
+ */
+rt_inline rt_uint32_t aht10_temp_raw(const rt_uint8_t *buf)
+{
+    return (rt_uint32_t)(buf[3] & 0x0F) << 16 | (rt_uint32_t)buf[4] << 8 | buf[5];
+}
+
+rt_inline rt_uint32_t aht10_humi_raw(const rt_uint8_t *buf)
+{
+    return (rt_uint32_t)buf[1] << 12 | (rt_uint32_t)buf[2] << 4 | buf[3] >> 4;
+}
+
+rt_inline rt_int32_t aht10_temp_to_dcelsius(rt_uint32_t raw)
+{
+    return (rt_int32_t)(((raw & 0xFFFFF) * 2000 + (1 << 19)) >> 20) - 500;
+}
+
+rt_inline rt_int32_t aht10_humi_to_permillage(rt_uint32_t raw)
+{
+    return (rt_int32_t)(((raw & 0xFFFFF) * 1000 + (1 << 19)) >> 20);
+}
+
+/**
+ * This function initializes aht10 registered device driver
+ *
+ * @param dev the name of aht10 device
+ *
+ * @return the aht10 device.
+ */
+aht10_device_t aht10_init(const char *i2c_bus_name);
+
+/**
+ * This function releases memory and deletes mutex lock
+ *
+ * @param dev the pointer of device driver structure
+ */
+void aht10_deinit(aht10_device_t dev);
+
+/**
+ * This function reads temperature by aht10 sensor measurement
+ *
+ * @param dev the pointer of device driver structure
+ *
+ * @return the relative temperature converted to float data.
+ */
+float aht10_read_temperature(aht10_device_t dev);
+
+/**
+ * This function reads relative humidity by aht10 sensor measurement
+ *
+ * @param dev the pointer of device driver structure
+ *
+ * @return the relative humidity converted to float data.
+ */
+float aht10_read_humidity(aht10_device_t dev);
+
+/**
+ * This function reads temperature by aht10 sensor measurement without floating point
+ *
+ * @param dev the pointer of device driver structure
+ *
+ * @return the temperature in 0.1 Celsius.
+ */
+rt_int32_t aht10_read_temperature_x10(aht10_device_t dev);
+
+/**
+ * This function reads relative humidity by aht10 sensor measurement without floating point
+ *
+ * @param dev the pointer of device driver structure
+ *
+ * @return the relative humidity in 0.1 %RH.
+ */
+rt_int32_t aht10_read_humidity_x10(aht10_device_t dev);
+
+/**
+ * This function reads temperature and relative humidity from one aht10 measurement
+ *
+ * @param dev the pointer of device driver structure
+ * @param temp the temperature in 0.1 Celsius
+ * @param humi the relative humidity in 0.1 %RH
+ *
+ * @return the operation status, RT_EOK on OK, temp and humi are left as they are on error.
+ */
+rt_err_t aht10_read_x10(aht10_device_t dev, rt_int32_t *temp, rt_int32_t *humi);
+
+#endif /* __DRV_AHT10_H__ */
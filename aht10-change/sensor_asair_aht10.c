@@ -1,226 +1,277 @@
-/*
- * Copyright (c) 2006-2018, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2019-05-08     yangjie      the first version
- * 2020-11-14     jingpengzhou Add alarm mode
- */
- 
-#include "sensor_asair_aht10.h"
-
-#define AHT10_I2C_BUS  "i2c1"
-
-#define DBG_TAG "sensor.asair.aht10"
-#define DBG_LVL DBG_INFO
-#include <rtdbg.h>
-
-#define SENSOR_TEMP_RANGE_MAX (85)
-#define SENSOR_TEMP_RANGE_MIN (-40)
-#define SENSOR_HUMI_RANGE_MAX (100)
-#define SENSOR_HUMI_RANGE_MIN (0)
-
-
-
- /*bee*/
-#include <rtthread.h>
-#include <stdlib.h>
-#include "../libraries/ls1c_public.h"
-#include "../libraries/ls1c_gpio.h"
-#define bee_gpio 55
-#define led2_gpio 05
-#define led3_gpio 58
-
-
-
-static struct aht10_device *temp_humi_dev;
-
-static rt_err_t _aht10_init(struct rt_sensor_intf *intf)
-{
-    temp_humi_dev = aht10_init(intf->dev_name);
-
-    if (temp_humi_dev == RT_NULL)
-    {
-        return -RT_ERROR;
-    }
-    
-    return RT_EOK;
-}
-
-static rt_size_t _aht10_polling_get_data(rt_sensor_t sensor, struct rt_sensor_data *data)
-{
-    float temperature_x10, humidity_x10;
-    
-    if (sensor->info.type == RT_SENSOR_CLASS_TEMP)
-    {
-        temperature_x10 = 10 * aht10_read_temperature(temp_humi_dev);
-        data->data.temp = (rt_int32_t)temperature_x10;
-        data->timestamp = rt_sensor_get_ts();
-
-        //bee gpioʼ
-        gpio_init(bee_gpio, gpio_mode_output);
-        gpio_set(bee_gpio, gpio_level_high);
-        // red led gpioʼ
-        gpio_init(led2_gpio, gpio_mode_output);
-       // gpio_set(led2_gpio, gpio_level_high);
-        gpio_set(led2_gpio, gpio_level_low);
-        // green led gpioʼ
-        gpio_init(led3_gpio, gpio_mode_output);
-        gpio_set(led3_gpio, gpio_level_high);
-
-        if (data->data.temp <= 450)
-        {
-            //green led 
-            gpio_set(led3_gpio, gpio_level_low);
-            delay_ms(1000);
-            gpio_set(led3_gpio, gpio_level_high);
-            delay_ms(1000);
-            //     rt_kprintf("current time: %d \n", i);
-        }
-        else
-        {
-            gpio_set(led3_gpio, gpio_level_low);
-        }
-        
-
-        if (data->data.temp > 450)
-        {
-            //bee 
-            gpio_set(bee_gpio, gpio_level_low);
-            delay_ms(3000);
-            gpio_set(bee_gpio, gpio_level_high);
-            delay_ms(3000);
-            //red led 
-            gpio_set(led2_gpio, gpio_level_low);
-            delay_ms(1000);
-            gpio_set(led2_gpio, gpio_level_high);
-            delay_ms(1000);
-     //     rt_kprintf("current time: %d \n", i);
-        }
-        else
-        {
-            gpio_set(led2_gpio, gpio_level_low);
-            gpio_set(bee_gpio, gpio_level_high);
-        }
-      //      gpio_set(bee_gpio, gpio_level_high);
-    }    
-    else if (sensor->info.type == RT_SENSOR_CLASS_HUMI)
-    {
-        humidity_x10    = 10 * aht10_read_humidity(temp_humi_dev);
-        data->data.humi = (rt_int32_t)humidity_x10;
-        data->timestamp = rt_sensor_get_ts();   
-    }
-    return 1;
-}
-
-static rt_size_t aht10_fetch_data(struct rt_sensor_device *sensor, void *buf, rt_size_t len)
-{
-    RT_ASSERT(buf);
-
-    if (sensor->config.mode == RT_SENSOR_MODE_POLLING)
-    {
-        return _aht10_polling_get_data(sensor, buf);
-    }
-    else
-        return 0;
-}
-
-static rt_err_t aht10_control(struct rt_sensor_device *sensor, int cmd, void *args)
-{
-    rt_err_t result = RT_EOK;
-
-    return result;
-}
-
-static struct rt_sensor_ops sensor_ops =
-{
-    aht10_fetch_data,
-    aht10_control
-};
-
-int rt_hw_aht10_init(const char *name, struct rt_sensor_config *cfg)
-{
-    rt_int8_t result;
-    rt_sensor_t sensor_temp = RT_NULL, sensor_humi = RT_NULL;
-    
-#ifdef PKG_USING_AHT10   
-    
-     /* temperature sensor register */
-    sensor_temp = rt_calloc(1, sizeof(struct rt_sensor_device));
-    if (sensor_temp == RT_NULL)
-        return -1;
-
-    sensor_temp->info.type       = RT_SENSOR_CLASS_TEMP;
-    sensor_temp->info.vendor     = RT_SENSOR_VENDOR_UNKNOWN;
-    sensor_temp->info.model      = "aht10";
-    sensor_temp->info.unit       = RT_SENSOR_UNIT_DCELSIUS;
-    sensor_temp->info.intf_type  = RT_SENSOR_INTF_I2C;
-    sensor_temp->info.range_max  = SENSOR_TEMP_RANGE_MAX;
-    sensor_temp->info.range_min  = SENSOR_TEMP_RANGE_MIN;
-    sensor_temp->info.period_min = 5;
-
-    rt_memcpy(&sensor_temp->config, cfg, sizeof(struct rt_sensor_config));
-    sensor_temp->ops = &sensor_ops;
-
-    result = rt_hw_sensor_register(sensor_temp, name, RT_DEVICE_FLAG_RDONLY, RT_NULL);
-    if (result != RT_EOK)
-    {
-        LOG_E("device register err code: %d", result);
-        goto __exit;
-    }
-    
-    /* humidity sensor register */
-    sensor_humi = rt_calloc(1, sizeof(struct rt_sensor_device));
-    if (sensor_humi == RT_NULL)
-        return -1;
-
-    sensor_humi->info.type       = RT_SENSOR_CLASS_HUMI;
-    sensor_humi->info.vendor     = RT_SENSOR_VENDOR_UNKNOWN;
-    sensor_humi->info.model      = "aht10";
-    sensor_humi->info.unit       = RT_SENSOR_UNIT_PERMILLAGE;
-    sensor_humi->info.intf_type  = RT_SENSOR_INTF_I2C;
-    sensor_humi->info.range_max  = SENSOR_HUMI_RANGE_MAX;
-    sensor_humi->info.range_min  = SENSOR_HUMI_RANGE_MIN;
-    sensor_humi->info.period_min = 5;
-
-    rt_memcpy(&sensor_humi->config, cfg, sizeof(struct rt_sensor_config));
-    sensor_humi->ops = &sensor_ops;
-
-    result = rt_hw_sensor_register(sensor_humi, name, RT_DEVICE_FLAG_RDONLY, RT_NULL);
-    if (result != RT_EOK)
-    {
-        LOG_E("device register err code: %d", result);
-        goto __exit;
-    }
-    
-#endif
-    
-    _aht10_init(&cfg->intf);
-    return RT_EOK;
-    
-__exit:
-    if (sensor_temp)
-        rt_free(sensor_temp);
-    if (sensor_humi)
-        rt_free(sensor_humi);
-    if (temp_humi_dev)
-        aht10_deinit(temp_humi_dev);
-    return -RT_ERROR;     
-}
-
-
-
-int rt_hw_aht10_port(void)
-{
-    struct rt_sensor_config cfg;
-
-    cfg.intf.dev_name = AHT10_I2C_BUS;
-    cfg.intf.user_data = (void*)AHT10_I2C_ADDR;
-
-    rt_hw_aht10_init("aht10", &cfg);
-
-    return RT_EOK;
-}
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-05-08     yangjie      the first version
+ * 2020-11-14     jingpengzhou Add alarm mode
+ */
+ 
+#include "sensor_asair_aht10.h"
+
+#define AHT10_I2C_BUS  "i2c1"
+
+#define DBG_TAG "sensor.asair.aht10"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#define SENSOR_TEMP_RANGE_MAX (85)
+#define SENSOR_TEMP_RANGE_MIN (-40)
+#define SENSOR_HUMI_RANGE_MAX (100)
+#define SENSOR_HUMI_RANGE_MIN (0)
+
+
+
+ /*bee*/
+#include <rtthread.h>
+#include <stdlib.h>
+#define bee_gpio 55
+#define led2_gpio 05
+#define led3_gpio 58
+
+/* Low level turns the buzzer and the LEDs on */
+static struct rt_sensor_alarm bee_alarm, led2_alarm, led3_alarm;
+
+static const struct rt_sensor_alarm_pattern alarm_steady   = {1, 0, 0};
+static const struct rt_sensor_alarm_pattern alarm_blink_1s = {1000, 1000, 0};
+static const struct rt_sensor_alarm_pattern alarm_beep_3s  = {3000, 3000, 0};
+
+
+
+static struct aht10_device *temp_humi_dev;
+
+static rt_err_t _aht10_init(struct rt_sensor_intf *intf)
+{
+    temp_humi_dev = aht10_init(intf->dev_name);
+
+    if (temp_humi_dev == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+    
+    return RT_EOK;
+}
+
+/* Over 45 C the buzzer beeps and the red led blinks, else the green led blinks */
+static void _aht10_post_alarm(rt_int32_t temp)
+{
+    if (temp > 450)
+    {
+        rt_sensor_alarm_set(&bee_alarm, &alarm_beep_3s);
+        rt_sensor_alarm_set(&led2_alarm, &alarm_blink_1s);
+        rt_sensor_alarm_set(&led3_alarm, &alarm_steady);
+    }
+    else
+    {
+        rt_sensor_alarm_set(&bee_alarm, RT_NULL);
+        rt_sensor_alarm_set(&led2_alarm, &alarm_steady);
+        rt_sensor_alarm_set(&led3_alarm, &alarm_blink_1s);
+    }
+}
+
+static void _aht10_fill_data(rt_sensor_t sensor, struct rt_sensor_data *data, rt_int32_t temp, rt_int32_t humi)
+{
+    /* timestamp_us is left to the framework, so all members of a fetch share it */
+    data->timestamp = rt_sensor_get_ts();
+    data->timestamp_us = 0;
+    data->flags = 0;
+
+    if (sensor->info.type == RT_SENSOR_CLASS_TEMP)
+    {
+        data->type = RT_SENSOR_CLASS_TEMP;
+        data->data.temp = temp;
+    }
+    else if (sensor->info.type == RT_SENSOR_CLASS_HUMI)
+    {
+        data->type = RT_SENSOR_CLASS_HUMI;
+        data->data.humi = humi;
+    }
+}
+
+static rt_size_t _aht10_polling_get_data(rt_sensor_t sensor, struct rt_sensor_data *data)
+{
+    rt_int32_t temp, humi;
+
+    if (aht10_read_x10(temp_humi_dev, &temp, &humi) != RT_EOK)
+    {
+        RT_SENSOR_STATS_INC(sensor, bus_errors);
+        return 0;
+    }
+    _aht10_fill_data(sensor, data, temp, humi);
+    _aht10_post_alarm(temp);
+
+    return 1;
+}
+
+static rt_size_t aht10_fetch_data(struct rt_sensor_device *sensor, void *buf, rt_size_t len)
+{
+    RT_ASSERT(buf);
+
+    if (sensor->config.mode == RT_SENSOR_MODE_POLLING)
+    {
+        return _aht10_polling_get_data(sensor, buf);
+    }
+    else
+        return 0;
+}
+
+/* Temperature and humidity come from the same measurement, serve both with one conversion */
+static rt_size_t aht10_fetch_module(struct rt_sensor_module *module, struct rt_sensor_data *buf)
+{
+    rt_int32_t temp, humi;
+    rt_uint8_t i;
+
+    if (module->sen[0]->config.mode != RT_SENSOR_MODE_POLLING)
+    {
+        return 0;
+    }
+
+    /* The fetch is booked on the first member */
+    if (aht10_read_x10(temp_humi_dev, &temp, &humi) != RT_EOK)
+    {
+        RT_SENSOR_STATS_INC(module->sen[0], bus_errors);
+        return 0;
+    }
+    for (i = 0; i < module->sen_num; i++)
+    {
+        _aht10_fill_data(module->sen[i], &buf[i], temp, humi);
+    }
+    _aht10_post_alarm(temp);
+
+    return module->sen_num;
+}
+
+static rt_err_t aht10_control(struct rt_sensor_device *sensor, int cmd, void *args)
+{
+    rt_err_t result = RT_EOK;
+
+    switch (cmd)
+    {
+    case RT_SENSOR_CTRL_SET_POWER:
+        /* The chip has no sleep command, it only idles between measurements by itself */
+        if (((rt_base_t)args & 0xFF) != RT_SENSOR_POWER_NORMAL)
+        {
+            result = -RT_ENOSYS;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return result;
+}
+
+static struct rt_sensor_ops sensor_ops =
+{
+    aht10_fetch_data,
+    aht10_control,
+    aht10_fetch_module
+};
+
+int rt_hw_aht10_init(const char *name, struct rt_sensor_config *cfg)
+{
+    rt_int8_t result;
+    rt_sensor_t sensor_temp = RT_NULL, sensor_humi = RT_NULL;
+    struct rt_sensor_module *module = RT_NULL;
+    
+#ifdef PKG_USING_AHT10   
+    
+    module = rt_calloc(1, sizeof(struct rt_sensor_module));
+    if (module == RT_NULL)
+        return -RT_ENOMEM;
+    /* A partner's fetch stays the newest sample for one measurement */
+    module->window = AHT10_MEASURE_MS;
+
+     /* temperature sensor register */
+    sensor_temp = rt_calloc(1, sizeof(struct rt_sensor_device));
+    if (sensor_temp == RT_NULL)
+        goto __exit;
+
+    sensor_temp->info.type       = RT_SENSOR_CLASS_TEMP;
+    sensor_temp->info.vendor     = RT_SENSOR_VENDOR_UNKNOWN;
+    sensor_temp->info.model      = "aht10";
+    sensor_temp->info.unit       = RT_SENSOR_UNIT_DCELSIUS;
+    sensor_temp->info.intf_type  = RT_SENSOR_INTF_I2C;
+    sensor_temp->info.range_max  = SENSOR_TEMP_RANGE_MAX;
+    sensor_temp->info.range_min  = SENSOR_TEMP_RANGE_MIN;
+    sensor_temp->info.period_min = 5;
+
+    rt_memcpy(&sensor_temp->config, cfg, sizeof(struct rt_sensor_config));
+    sensor_temp->ops = &sensor_ops;
+    sensor_temp->module = module;
+
+    result = rt_hw_sensor_register(sensor_temp, name, RT_DEVICE_FLAG_RDONLY | RT_DEVICE_FLAG_FIFO_RX, RT_NULL);
+    if (result != RT_EOK)
+    {
+        LOG_E("device register err code: %d", result);
+        goto __exit;
+    }
+    
+    /* humidity sensor register */
+    sensor_humi = rt_calloc(1, sizeof(struct rt_sensor_device));
+    if (sensor_humi == RT_NULL)
+        goto __exit;
+
+    sensor_humi->info.type       = RT_SENSOR_CLASS_HUMI;
+    sensor_humi->info.vendor     = RT_SENSOR_VENDOR_UNKNOWN;
+    sensor_humi->info.model      = "aht10";
+    sensor_humi->info.unit       = RT_SENSOR_UNIT_PERMILLAGE;
+    sensor_humi->info.intf_type  = RT_SENSOR_INTF_I2C;
+    sensor_humi->info.range_max  = SENSOR_HUMI_RANGE_MAX;
+    sensor_humi->info.range_min  = SENSOR_HUMI_RANGE_MIN;
+    sensor_humi->info.period_min = 5;
+
+    rt_memcpy(&sensor_humi->config, cfg, sizeof(struct rt_sensor_config));
+    sensor_humi->ops = &sensor_ops;
+    sensor_humi->module = module;
+
+    result = rt_hw_sensor_register(sensor_humi, name, RT_DEVICE_FLAG_RDONLY | RT_DEVICE_FLAG_FIFO_RX, RT_NULL);
+    if (result != RT_EOK)
+    {
+        LOG_E("device register err code: %d", result);
+        goto __exit;
+    }
+
+    module->sen[0] = sensor_temp;
+    module->sen[1] = sensor_humi;
+    module->sen_num = 2;
+    
+#endif
+    
+    rt_sensor_alarm_init(&bee_alarm, "bee", bee_gpio, PIN_LOW);
+    rt_sensor_alarm_init(&led2_alarm, "led2", led2_gpio, PIN_LOW);
+    rt_sensor_alarm_init(&led3_alarm, "led3", led3_gpio, PIN_LOW);
+
+    _aht10_init(&cfg->intf);
+    return RT_EOK;
+    
+__exit:
+    if (sensor_temp)
+        rt_free(sensor_temp);
+    if (sensor_humi)
+        rt_free(sensor_humi);
+    if (module)
+        rt_free(module);
+    if (temp_humi_dev)
+        aht10_deinit(temp_humi_dev);
+    return -RT_ERROR;     
+}
+
+
+
+int rt_hw_aht10_port(void)
+{
+    struct rt_sensor_config cfg;
+
+    rt_memset(&cfg, 0, sizeof(cfg));
+    cfg.intf.dev_name = AHT10_I2C_BUS;
+    cfg.intf.user_data = (void*)AHT10_I2C_ADDR;
+    cfg.irq_pin.pin = RT_PIN_NONE;
+
+    rt_hw_aht10_init("aht10", &cfg);
+
+    return RT_EOK;
+}
 INIT_ENV_EXPORT(rt_hw_aht10_port);
\ No newline at end of file
@@ -1,138 +1,400 @@
-/*
- * Copyright (c) 2006-2019, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2019-4-30     Sanjay_Wu  the first version
- */
-
-#include <rthw.h>
-#include <rtthread.h>
-#include <rtdevice.h>
-
-#define DBG_ENABLE
-#define DBG_SECTION_NAME "bh1750"
-#define DBG_LEVEL DBG_LOG
-#define DBG_COLOR
-#include <rtdbg.h>
-#include "bh1750.h"
-
-
-#ifdef PKG_USING_BH1750_LATEST_VERSION
-
-static rt_err_t bh1750_read_regs(struct rt_i2c_bus_device *bus, rt_uint8_t len, rt_uint8_t *buf)
-{
-    struct rt_i2c_msg msgs;
-
-    msgs.addr = BH1750_ADDR;
-    msgs.flags = RT_I2C_RD;
-    msgs.buf = buf;
-    msgs.len = len;
-
-    if (1 == rt_i2c_transfer(bus, &msgs, 1))
-    {
-        return RT_EOK;
-    }
-    else
-    {
-        return -RT_ERROR;
-    }
-}
-
-static rt_err_t bh1750_write_cmd(struct rt_i2c_bus_device *bus, rt_uint8_t cmd)
-{
-    struct rt_i2c_msg msgs;
-
-    msgs.addr = BH1750_ADDR;
-    msgs.flags = RT_I2C_WR;
-    msgs.buf = &cmd;
-    msgs.len = 1;
-
-    if (1 == rt_i2c_transfer(bus, &msgs, 1))
-    {
-        return RT_EOK;
-    }
-    else
-    {
-        return -RT_ERROR;
-    }
-}
-
-static rt_err_t bh1750_set_measure_mode(bh1750_device_t hdev, rt_uint8_t mode, rt_uint8_t m_time)
-{
-    RT_ASSERT(hdev);
-
-    if (RT_EOK == bh1750_write_cmd(hdev->bus, BH1750_RESET) &&
-        RT_EOK == bh1750_write_cmd(hdev->bus, mode))
-    {
-        rt_thread_mdelay(m_time);
-        return RT_EOK;
-    }
-    else
-    {
-        LOG_D("bh1750 set measure mode failed!");
-        return -RT_ERROR;
-    }
-}
-
-rt_err_t bh1750_power_on(bh1750_device_t hdev)
-{
-    RT_ASSERT(hdev);
-
-    if (RT_EOK == bh1750_write_cmd(hdev->bus, BH1750_POWER_ON))
-    {
-        return RT_EOK;
-    }
-    else
-    {
-        LOG_D("bh1750 power on failed!");
-        return -RT_ERROR;
-    }
-}
-
-rt_err_t bh1750_power_down(bh1750_device_t hdev)
-{
-    RT_ASSERT(hdev);
-
-    if (RT_EOK == bh1750_write_cmd(hdev->bus, BH1750_POWER_DOWN))
-    {
-        return RT_EOK;
-    }
-    else
-    {
-        LOG_D("bh1750 power down failed!");
-        return -RT_ERROR;
-    }
-}
-
-rt_err_t bh1750_init(bh1750_device_t hdev, const char *i2c_bus_name)
-{
-    hdev->bus = rt_i2c_bus_device_find(i2c_bus_name);
-    if (RT_NULL == hdev->bus)
-    {
-        LOG_E("Can't find bh1750 device on '%s' ", i2c_bus_name);
-        rt_free(hdev->bus);
-        return -RT_ERROR;
-    }
-
-    return RT_EOK;
-}
-
-float bh1750_read_light(bh1750_device_t hdev)
-{
-    rt_uint8_t temp[2];
-    float current_light = 0;
-
-    RT_ASSERT(hdev);
-
-    bh1750_set_measure_mode(hdev, BH1750_CON_H_RES_MODE2, 120);
-    bh1750_read_regs(hdev->bus, 2, temp);
-    current_light = ((float)((temp[0] << 8) + temp[1]) / 1.2);
-
-    return current_light;
-}
-
-#endif /* PKG_USING_BH1750_LATEST_VERSION */
-
+/*
+ * Copyright (c) 2006-2019, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-4-30     Sanjay_Wu  the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#define DBG_ENABLE
+#define DBG_SECTION_NAME "bh1750"
+#define DBG_LEVEL DBG_LOG
+#define DBG_COLOR
+#include <rtdbg.h>
+#include "bh1750.h"
+
+
+#ifdef PKG_USING_BH1750_LATEST_VERSION
+
+static rt_err_t bh1750_read_regs(struct rt_i2c_bus_device *bus, rt_uint8_t len, rt_uint8_t *buf)
+{
+    struct rt_i2c_msg msgs;
+
+    msgs.addr = BH1750_ADDR;
+    msgs.flags = RT_I2C_RD;
+    msgs.buf = buf;
+    msgs.len = len;
+
+    if (1 == rt_i2c_transfer(bus, &msgs, 1))
+    {
+        return RT_EOK;
+    }
+    else
+    {
+        return -RT_ERROR;
+    }
+}
+
+static rt_err_t bh1750_write_cmd(struct rt_i2c_bus_device *bus, rt_uint8_t cmd)
+{
+    struct rt_i2c_msg msgs;
+
+    msgs.addr = BH1750_ADDR;
+    msgs.flags = RT_I2C_WR;
+    msgs.buf = &cmd;
+    msgs.len = 1;
+
+    if (1 == rt_i2c_transfer(bus, &msgs, 1))
+    {
+        return RT_EOK;
+    }
+    else
+    {
+        return -RT_ERROR;
+    }
+}
+
+static rt_err_t bh1750_set_measure_mode(bh1750_device_t hdev, rt_uint8_t mode, rt_uint32_t m_time)
+{
+    RT_ASSERT(hdev);
+
+    if (RT_EOK == bh1750_write_cmd(hdev->bus, BH1750_RESET) &&
+        RT_EOK == bh1750_write_cmd(hdev->bus, mode))
+    {
+        rt_thread_mdelay(m_time);
+        return RT_EOK;
+    }
+    else
+    {
+        LOG_D("bh1750 set measure mode failed!");
+        return -RT_ERROR;
+    }
+}
+
+rt_err_t bh1750_power_on(bh1750_device_t hdev)
+{
+    RT_ASSERT(hdev);
+
+    if (RT_EOK == bh1750_write_cmd(hdev->bus, BH1750_POWER_ON))
+    {
+        return RT_EOK;
+    }
+    else
+    {
+        LOG_D("bh1750 power on failed!");
+        return -RT_ERROR;
+    }
+}
+
+rt_err_t bh1750_power_down(bh1750_device_t hdev)
+{
+    RT_ASSERT(hdev);
+
+    if (RT_EOK == bh1750_write_cmd(hdev->bus, BH1750_POWER_DOWN))
+    {
+        return RT_EOK;
+    }
+    else
+    {
+        LOG_D("bh1750 power down failed!");
+        return -RT_ERROR;
+    }
+}
+
+rt_err_t bh1750_init(bh1750_device_t hdev, const char *i2c_bus_name)
+{
+    hdev->mtreg = BH1750_MTREG_DEFAULT;
+    hdev->cont_mode = 0;
+    hdev->cont_ready = RT_FALSE;
+    hdev->auto_range = RT_FALSE;
+    hdev->bus = rt_i2c_bus_device_find(i2c_bus_name);
+    if (RT_NULL == hdev->bus)
+    {
+        LOG_E("Can't find bh1750 device on '%s' ", i2c_bus_name);
+        rt_free(hdev->bus);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/* Worst case time of one measurement in 'mode' at the current MTreg */
+static rt_uint32_t bh1750_measure_time(bh1750_device_t hdev, rt_uint8_t mode)
+{
+    rt_uint32_t ms = (mode == BH1750_CON_L_RES_MODE || mode == BH1750_ONE_L_RES_MODE) ?
+                     BH1750_L_RES_TIME_MAX : BH1750_H_RES_TIME_MAX;
+
+    return (ms * hdev->mtreg + BH1750_MTREG_DEFAULT - 1) / BH1750_MTREG_DEFAULT;
+}
+
+/**
+ * This function starts a continuous measurement mode, the chip then
+ * integrates in the background and a read only fetches the latest result.
+ *
+ * @param hdev the device
+ * @param mode BH1750_CON_H_RES_MODE, BH1750_CON_H_RES_MODE2 or BH1750_CON_L_RES_MODE
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t bh1750_start_continuous(bh1750_device_t hdev, rt_uint8_t mode)
+{
+    RT_ASSERT(hdev);
+
+    if (mode != BH1750_CON_H_RES_MODE && mode != BH1750_CON_H_RES_MODE2 && mode != BH1750_CON_L_RES_MODE)
+    {
+        return -RT_EINVAL;
+    }
+
+    if (RT_EOK != bh1750_write_cmd(hdev->bus, BH1750_POWER_ON) ||
+        RT_EOK != bh1750_write_cmd(hdev->bus, mode))
+    {
+        LOG_D("bh1750 start continuous mode failed!");
+        return -RT_ERROR;
+    }
+
+    hdev->cont_mode = mode;
+    hdev->cont_ready = RT_FALSE;
+    /* A mode asked for explicitly ends the auto range */
+    hdev->auto_range = RT_FALSE;
+    hdev->ready_tick = rt_tick_get() + rt_tick_from_millisecond(bh1750_measure_time(hdev, mode));
+
+    return RT_EOK;
+}
+
+/**
+ * This function stops the continuous measurement and powers the chip down,
+ * reads go back to one measurement each.
+ *
+ * @param hdev the device
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t bh1750_stop_continuous(bh1750_device_t hdev)
+{
+    RT_ASSERT(hdev);
+
+    hdev->cont_mode = 0;
+    hdev->auto_range = RT_FALSE;
+
+    return bh1750_power_down(hdev);
+}
+
+/**
+ * This function sets the measurement time register. A larger MTreg
+ * integrates longer for a finer resolution and a lower maximum.
+ *
+ * @param hdev the device
+ * @param mtreg BH1750_MTREG_MIN to BH1750_MTREG_MAX, BH1750_MTREG_DEFAULT after reset
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t bh1750_set_mtreg(bh1750_device_t hdev, rt_uint8_t mtreg)
+{
+    RT_ASSERT(hdev);
+
+    if (mtreg < BH1750_MTREG_MIN || mtreg > BH1750_MTREG_MAX)
+    {
+        return -RT_EINVAL;
+    }
+
+    if (RT_EOK != bh1750_write_cmd(hdev->bus, BH1750_MTREG_HIGH | mtreg >> 5) ||
+        RT_EOK != bh1750_write_cmd(hdev->bus, BH1750_MTREG_LOW | (mtreg & 0x1F)))
+    {
+        LOG_D("bh1750 set MTreg failed!");
+        return -RT_ERROR;
+    }
+    hdev->mtreg = mtreg;
+
+    /* A running continuous mode restarts with the new time */
+    if (hdev->cont_mode != 0)
+    {
+        return bh1750_start_continuous(hdev, hdev->cont_mode);
+    }
+
+    return RT_EOK;
+}
+
+/* Auto range steps from fast and coarse to slow and fine */
+#define BH1750_AUTO_CHANGE_LUX  8   /* lx, a smaller change is noise of the L-resolution */
+
+static const struct bh1750_range
+{
+    rt_uint8_t  mode;
+    rt_uint8_t  mtreg;
+    rt_uint16_t finer_below;    /* lx, step to the next range under this */
+    rt_uint16_t coarser_above;  /* lx, step back to the previous range over this */
+} bh1750_ranges[] =
+{
+    {BH1750_CON_L_RES_MODE,  BH1750_MTREG_DEFAULT, 1000, 0xFFFF},  /* 4 lx, 24 ms */
+    {BH1750_CON_H_RES_MODE,  BH1750_MTREG_DEFAULT, 100,  2000},    /* 1 lx, 180 ms */
+    {BH1750_CON_H_RES_MODE2, BH1750_MTREG_DEFAULT, 10,   200},     /* 0.5 lx, 180 ms */
+    {BH1750_CON_H_RES_MODE2, BH1750_MTREG_MAX,     0,    20},      /* 0.12 lx, 663 ms, up to 7417 lx */
+};
+
+static rt_err_t bh1750_apply_range(bh1750_device_t hdev, rt_uint8_t range)
+{
+    rt_err_t result = RT_EOK;
+
+    hdev->range = range;
+    if (hdev->mtreg != bh1750_ranges[range].mtreg)
+    {
+        /* Written before the mode, so it only restarts once */
+        hdev->cont_mode = 0;
+        result = bh1750_set_mtreg(hdev, bh1750_ranges[range].mtreg);
+    }
+    if (result == RT_EOK)
+    {
+        result = bh1750_start_continuous(hdev, bh1750_ranges[range].mode);
+    }
+    hdev->auto_range = RT_TRUE;
+
+    return result;
+}
+
+/*
+ * Pick the range for the next result. Saturation or a sudden change, most
+ * of all a sudden darkening, goes straight to the 24 ms L-resolution so
+ * the next results follow the light quickly; steady light then steps one
+ * range finer per result down to 0.12 lx.
+ */
+static void bh1750_auto_range(bh1750_device_t hdev, rt_uint16_t raw, rt_uint32_t lux)
+{
+    const struct bh1750_range *cur = &bh1750_ranges[hdev->range];
+    rt_uint32_t delta = lux > hdev->last_lux ? lux - hdev->last_lux : hdev->last_lux - lux;
+    rt_uint8_t range = hdev->range;
+
+    if (raw == 0xFFFF || (range > 0 && delta > BH1750_AUTO_CHANGE_LUX && delta > hdev->last_lux / 2))
+    {
+        range = 0;
+    }
+    else if (lux > cur->coarser_above)
+    {
+        range--;
+    }
+    else if (lux < cur->finer_below)
+    {
+        range++;
+    }
+    hdev->last_lux = lux;
+
+    if (range != hdev->range)
+    {
+        bh1750_apply_range(hdev, range);
+    }
+}
+
+/**
+ * This function starts continuous measurement with auto ranging: the
+ * L-resolution while the light is bright or changing, the H-resolution
+ * modes and a longer MTreg in steady low light.
+ *
+ * @param hdev the device
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t bh1750_start_auto_range(bh1750_device_t hdev)
+{
+    RT_ASSERT(hdev);
+
+    hdev->last_lux = 0;
+
+    return bh1750_apply_range(hdev, 0);
+}
+
+static rt_err_t bh1750_read_raw(bh1750_device_t hdev, rt_uint16_t *raw)
+{
+    rt_uint8_t temp[2];
+
+    RT_ASSERT(hdev);
+
+    if (hdev->cont_mode == 0)
+    {
+        bh1750_set_measure_mode(hdev, BH1750_CON_H_RES_MODE2, 120 * hdev->mtreg / BH1750_MTREG_DEFAULT);
+    }
+    else if (!hdev->cont_ready)
+    {
+        /* Only the first result after the start is waited for, later reads get the latest one */
+        rt_tick_t now = rt_tick_get();
+
+        if ((rt_int32_t)(hdev->ready_tick - now) > 0)
+        {
+            rt_thread_delay(hdev->ready_tick - now);
+        }
+        hdev->cont_ready = RT_TRUE;
+    }
+
+    if (bh1750_read_regs(hdev->bus, 2, temp) != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+    *raw = (temp[0] << 8) + temp[1];
+
+    return RT_EOK;
+}
+
+/**
+ * This function reads the light.
+ *
+ * @param hdev the device
+ *
+ * @return the light in lux, a negative value if the bus failed.
+ */
+float bh1750_read_light(bh1750_device_t hdev)
+{
+    float current_light = 0;
+    rt_uint16_t raw;
+
+    if (bh1750_read_raw(hdev, &raw) != RT_EOK)
+    {
+        return -1;
+    }
+
+    current_light = ((float)raw / 1.2 * BH1750_MTREG_DEFAULT / hdev->mtreg);
+    /* The H-resolution mode2 counts 0.5 lx */
+    if (hdev->cont_mode == 0 || hdev->cont_mode == BH1750_CON_H_RES_MODE2)
+    {
+        current_light /= 2;
+    }
+    if (hdev->auto_range)
+    {
+        bh1750_auto_range(hdev, raw, (rt_uint32_t)current_light);
+    }
+
+    return current_light;
+}
+
+/**
+ * This function reads the light in whole lux without float arithmetic. A
+ * failed read leaves the auto range where it is.
+ *
+ * @param hdev the device
+ * @param lux the light in lux
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t bh1750_read_lux(bh1750_device_t hdev, rt_uint32_t *lux)
+{
+    rt_uint16_t raw;
+
+    if (bh1750_read_raw(hdev, &raw) != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    *lux = bh1750_raw_to_lux(raw, hdev->cont_mode ? hdev->cont_mode : BH1750_CON_H_RES_MODE2, hdev->mtreg);
+    if (hdev->auto_range)
+    {
+        bh1750_auto_range(hdev, raw, *lux);
+    }
+
+    return RT_EOK;
+}
+
+#endif /* PKG_USING_BH1750_LATEST_VERSION */
+
@@ -1,42 +1,83 @@
-/*
- * Copyright (c) 2006-2019, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2019-04-30     Sanjay_Wu  the first version
- */
-
-#ifndef __BH1750_H__
-#define __BH1750_H__
-
-#include <rthw.h>
-#include <rtthread.h>
-
-/*bh1750 device address */
-#define BH1750_ADDR 0x23
-
-/*bh1750 registers define */
-#define BH1750_POWER_DOWN   	0x00	// power down
-#define BH1750_POWER_ON			0x01	// power on
-#define BH1750_RESET			0x07	// reset	
-#define BH1750_CON_H_RES_MODE	0x10	// Continuously H-Resolution Mode
-#define BH1750_CON_H_RES_MODE2	0x11	// Continuously H-Resolution Mode2 
-#define BH1750_CON_L_RES_MODE	0x13	// Continuously L-Resolution Mode
-#define BH1750_ONE_H_RES_MODE	0x20	// One Time H-Resolution Mode
-#define BH1750_ONE_H_RES_MODE2	0x21	// One Time H-Resolution Mode2
-#define BH1750_ONE_L_RES_MODE	0x23	// One Time L-Resolution Mode
-
-struct bh1750_device
-{	
-    struct rt_i2c_bus_device *bus;
-};
-typedef struct bh1750_device *bh1750_device_t;
-
-rt_err_t bh1750_power_on(bh1750_device_t hdev);
-rt_err_t bh1750_power_down(bh1750_device_t hdev);
-rt_err_t bh1750_init(bh1750_device_t hdev, const char *i2c_bus_name);
-float bh1750_read_light(bh1750_device_t hdev);
-
-#endif /* __BH1750_H__ */
+/*
+ * Copyright (c) 2006-2019, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-04-30     Sanjay_Wu  the first version
+ */
+
+#ifndef __BH1750_H__
+#define __BH1750_H__
+
+#include <rthw.h>
+#include <rtthread.h>
+
+/*bh1750 device address */
+#define BH1750_ADDR 0x23
+
+/*bh1750 registers define */
+#define BH1750_POWER_DOWN   	0x00	// power down
+#define BH1750_POWER_ON			0x01	// power on
+#define BH1750_RESET			0x07	// reset	
+#define BH1750_CON_H_RES_MODE	0x10	// Continuously H-Resolution Mode
+#define BH1750_CON_H_RES_MODE2	0x11	// Continuously H-Resolution Mode2 
+#define BH1750_CON_L_RES_MODE	0x13	// Continuously L-Resolution Mode
+#define BH1750_ONE_H_RES_MODE	0x20	// One Time H-Resolution Mode
+#define BH1750_ONE_H_RES_MODE2	0x21	// One Time H-Resolution Mode2
+#define BH1750_ONE_L_RES_MODE	0x23	// One Time L-Resolution Mode
+#define BH1750_MTREG_HIGH		0x40	// Change Measurement time, 01000_MT[7,6,5]
+#define BH1750_MTREG_LOW		0x60	// Change Measurement time, 011_MT[4,3,2,1,0]
+
+#define BH1750_MTREG_DEFAULT	69		// measurement time register after reset
+#define BH1750_MTREG_MIN		31
+#define BH1750_MTREG_MAX		254
+
+/* Maximum measurement times at the default MTreg, the first result after a start may take this long */
+#define BH1750_H_RES_TIME_MAX	180		// ms, H-Resolution Mode and Mode2
+#define BH1750_L_RES_TIME_MAX	24		// ms, L-Resolution Mode
+
+/*
+ * Integer conversion of a measurement result to lux, rounded to nearest:
+ *   lux = count / 1.2 * (69 / MTreg), halved again in the H-resolution mode2
+ * count * 5 * 69 stays below 2^25, so 32-bit arithmetic is exact.
+ */
+rt_inline rt_uint32_t bh1750_raw_to_lux(rt_uint16_t raw, rt_uint8_t mode, rt_uint8_t mtreg)
+{
+    rt_uint32_t div = 6 * (rt_uint32_t)mtreg;
+
+    if (mode == BH1750_CON_H_RES_MODE2 || mode == BH1750_ONE_H_RES_MODE2)
+    {
+        div *= 2;
+    }
+
+    return ((rt_uint32_t)raw * 5 * BH1750_MTREG_DEFAULT + div / 2) / div;
+}
+
+struct bh1750_device
+{	
+    struct rt_i2c_bus_device *bus;
+
+    rt_uint8_t  mtreg;          /* Measurement time register */
+    rt_uint8_t  cont_mode;      /* Running continuous mode, 0 = one measurement per read */
+    rt_bool_t   cont_ready;     /* A continuous result has been completed */
+    rt_tick_t   ready_tick;     /* When the first continuous result is complete */
+
+    rt_bool_t   auto_range;     /* Pick mode and MTreg from the light, see bh1750_start_auto_range() */
+    rt_uint8_t  range;          /* Current step of the auto range */
+    rt_uint32_t last_lux;       /* Previous auto range result */
+};
+typedef struct bh1750_device *bh1750_device_t;
+
+rt_err_t bh1750_power_on(bh1750_device_t hdev);
+rt_err_t bh1750_power_down(bh1750_device_t hdev);
+rt_err_t bh1750_init(bh1750_device_t hdev, const char *i2c_bus_name);
+float bh1750_read_light(bh1750_device_t hdev);
+rt_err_t bh1750_read_lux(bh1750_device_t hdev, rt_uint32_t *lux);
+rt_err_t bh1750_start_continuous(bh1750_device_t hdev, rt_uint8_t mode);
+rt_err_t bh1750_stop_continuous(bh1750_device_t hdev);
+rt_err_t bh1750_set_mtreg(bh1750_device_t hdev, rt_uint8_t mtreg);
+rt_err_t bh1750_start_auto_range(bh1750_device_t hdev);
+
+#endif /* __BH1750_H__ */
@@ -1,37 +1,37 @@
-/*
- * Copyright (c) 2006-2019, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2019-04-30     Sanjay_Wu  the first version
- */
-
-#ifndef __SENSOR_ROHM_BH1750_H__
-#define __SENSOR_ROHM_BH1750_H__
-
-#include <sensor.h>
-
-int rt_hw_bh1750_init(const char *name, struct rt_sensor_config *cfg);
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-#endif
+/*
+ * Copyright (c) 2006-2019, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-04-30     Sanjay_Wu  the first version
+ */
+
+#ifndef __SENSOR_ROHM_BH1750_H__
+#define __SENSOR_ROHM_BH1750_H__
+
+#include <sensor.h>
+
+int rt_hw_bh1750_init(const char *name, struct rt_sensor_config *cfg);
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+#endif
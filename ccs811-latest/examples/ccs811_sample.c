@@ -1,58 +1,105 @@
-/*
- * Copyright (c) 2020, RudyLo <luhuadong@163.com>
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2020-06-21     luhuadong    the first version
- */
-
-#include <rtthread.h>
-#include <rtdevice.h>
-#include <board.h>
-#include "ccs811.h"
-
-#define CCS811_I2C_BUS_NAME       "i2c2"
-
-/* cat_ccs811 */
-static void cat_ccs811(void)
-{
-    rt_uint16_t loop = 20;
-    ccs811_device_t ccs811 = ccs811_create(CCS811_I2C_BUS_NAME);
-
-    if(!ccs811) 
-    {
-        rt_kprintf("(CCS811) Init failed\n");
-        return;
-    }
-
-    ccs811_set_measure_cycle(ccs811, CCS811_CYCLE_250MS);
-    ccs811_set_baseline(ccs811, 0x847B);
-
-    while (loop)
-    {
-        if (ccs811_check_ready(ccs811))
-        {
-            /* Read TVOC and eCO2 */
-            if(!ccs811_measure(ccs811))
-            {
-                rt_kprintf("(CCS811) Measurement failed\n");
-                ccs811_delete(ccs811);
-                break;
-            }
-            rt_kprintf("[%2u] TVOC: %d ppb, eCO2: %d ppm\n", loop--, ccs811->TVOC, ccs811->eCO2);
-
-            if (loop % 5 == 0)
-                rt_kprintf("==> baseline: 0x%x\n", ccs811_get_baseline(ccs811));
-        }
-
-        rt_thread_mdelay(1000);
-    }
-    
-    ccs811_delete(ccs811);
-}
-
-#ifdef FINSH_USING_MSH
-MSH_CMD_EXPORT(cat_ccs811, read ccs811 TVOC and eCO2);
-#endif
+/*
+ * Copyright (c) 2020, RudyLo <luhuadong@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2020-06-21     luhuadong    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <board.h>
+#include "ccs811.h"
+
+#define CCS811_I2C_BUS_NAME       "i2c2"
+
+#ifdef PKG_USING_CCS811_INT_PIN
+static rt_sem_t ccs811_ready_sem = RT_NULL;
+
+/* nINT falls when a new result is ready, reading ALG_RESULT_DATA releases it */
+static void ccs811_ready_isr(void *args)
+{
+    rt_sem_release(ccs811_ready_sem);
+}
+
+/* Wait for a new result, a timeout re-arms nINT in case an edge was missed */
+static rt_bool_t ccs811_wait_ready(ccs811_device_t ccs811)
+{
+    if (rt_sem_take(ccs811_ready_sem, rt_tick_from_millisecond(1000)) == RT_EOK)
+        return RT_TRUE;
+
+    ccs811_measure(ccs811);
+    return RT_FALSE;
+}
+#endif
+
+/* cat_ccs811 */
+static void cat_ccs811(void)
+{
+    rt_uint16_t loop = 20;
+    ccs811_device_t ccs811 = ccs811_create(CCS811_I2C_BUS_NAME);
+
+    if(!ccs811) 
+    {
+        rt_kprintf("(CCS811) Init failed\n");
+        return;
+    }
+
+#ifdef PKG_USING_CCS811_INT_PIN
+    ccs811_ready_sem = rt_sem_create("cs8_rdy", 0, RT_IPC_FLAG_FIFO);
+    if (!ccs811_ready_sem)
+    {
+        ccs811_delete(ccs811);
+        return;
+    }
+    rt_pin_mode(PKG_USING_CCS811_INT_PIN, PIN_MODE_INPUT_PULLUP);
+    rt_pin_attach_irq(PKG_USING_CCS811_INT_PIN, PIN_IRQ_MODE_FALLING, ccs811_ready_isr, RT_NULL);
+    rt_pin_irq_enable(PKG_USING_CCS811_INT_PIN, RT_TRUE);
+
+    ccs811_set_measure_mode(ccs811, 0, 1, CCS811_MODE_4);
+#else
+    ccs811_set_measure_cycle(ccs811, CCS811_CYCLE_250MS);
+#endif
+    ccs811_set_baseline(ccs811, 0x847B);
+
+    while (loop)
+    {
+#ifdef PKG_USING_CCS811_INT_PIN
+        if (ccs811_wait_ready(ccs811))
+#else
+        if (ccs811_check_ready(ccs811))
+#endif
+        {
+            /* Read TVOC and eCO2 */
+            if(!ccs811_measure(ccs811))
+            {
+                rt_kprintf("(CCS811) Measurement failed\n");
+                ccs811_delete(ccs811);
+                break;
+            }
+            rt_kprintf("[%2u] TVOC: %d ppb, eCO2: %d ppm\n", loop--, ccs811->TVOC, ccs811->eCO2);
+
+            if (loop % 5 == 0)
+                rt_kprintf("==> baseline: 0x%x\n", ccs811_get_baseline(ccs811));
+        }
+
+#ifndef PKG_USING_CCS811_INT_PIN
+        rt_thread_mdelay(1000);
+#endif
+    }
+
+#ifdef PKG_USING_CCS811_INT_PIN
+    rt_pin_irq_enable(PKG_USING_CCS811_INT_PIN, RT_FALSE);
+    rt_pin_detach_irq(PKG_USING_CCS811_INT_PIN);
+    rt_sem_delete(ccs811_ready_sem);
+    ccs811_ready_sem = RT_NULL;
+#endif
+    
+    ccs811_delete(ccs811);
+}
+
+#ifdef FINSH_USING_MSH
+MSH_CMD_EXPORT(cat_ccs811, read ccs811 TVOC and eCO2);
+#endif
@@ -1,119 +1,128 @@
-/*
- * Copyright (c) 2020, RudyLo <luhuadong@163.com>
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2020-06-21     luhuadong    the first version
- */
-
-#include <rtthread.h>
-#include <rtdevice.h>
-#include <board.h>
-#include "ccs811.h"
-
-#define CCS811_I2C_BUS_NAME       "i2c2"
-
-static void read_tvoc_entry(void *args)
-{
-    rt_device_t tvoc_dev = RT_NULL;
-    struct rt_sensor_data sensor_data;
-
-    tvoc_dev = rt_device_find(args);
-    if (!tvoc_dev) 
-    {
-        rt_kprintf("Can't find TVOC device.\n");
-        return;
-    }
-
-    if (rt_device_open(tvoc_dev, RT_DEVICE_FLAG_RDWR))
-    {
-        rt_kprintf("Open TVOC device failed.\n");
-        return;
-    }
-
-    rt_uint16_t loop = 20;
-    while (loop--)
-    {
-        if (1 != rt_device_read(tvoc_dev, 0, &sensor_data, 1))
-        {
-            rt_kprintf("Read TVOC data failed.\n");
-            continue;
-        }
-        rt_kprintf("[%d] TVOC: %d\n", sensor_data.timestamp, sensor_data.data.tvoc);
-
-        rt_thread_mdelay(1000);
-    }
-
-    rt_device_close(tvoc_dev);
-}
-
-static void read_eco2_entry(void *args)
-{
-    rt_device_t eco2_dev = RT_NULL;
-    struct rt_sensor_data sensor_data;
-
-    eco2_dev = rt_device_find(args);
-    if (!eco2_dev) 
-    {
-        rt_kprintf("Can't find eCO2 device.\n");
-        return;
-    }
-
-    if (rt_device_open(eco2_dev, RT_DEVICE_FLAG_RDWR))
-    {
-        rt_kprintf("Open eCO2 device failed.\n");
-        return;
-    }
-
-    rt_uint16_t loop = 20;
-    while (loop--)
-    {
-        if (1 != rt_device_read(eco2_dev, 0, &sensor_data, 1))
-        {
-            rt_kprintf("Read eCO2 data failed.\n");
-            continue;
-        }
-        rt_kprintf("[%d] eCO2: %d\n", sensor_data.timestamp, sensor_data.data.eco2);
-
-        rt_thread_mdelay(1000);
-    }
-
-    rt_device_close(eco2_dev);
-}
-
-static int ccs811_read_sample(void)
-{
-    rt_thread_t tvoc_thread, eco2_thread;
-
-    tvoc_thread = rt_thread_create("tvoc_th", read_tvoc_entry, 
-                                   "tvoc_cs8", 1024, 
-                                    RT_THREAD_PRIORITY_MAX / 2, 20);
-    
-    
-    eco2_thread = rt_thread_create("eco2_th", read_eco2_entry, 
-                                   "eco2_cs8", 1024, 
-                                    RT_THREAD_PRIORITY_MAX / 2, 20);
-
-    if (tvoc_thread) 
-        rt_thread_startup(tvoc_thread);
-
-    if (eco2_thread) 
-        rt_thread_startup(eco2_thread);
-}
-#ifdef FINSH_USING_MSH
-MSH_CMD_EXPORT(ccs811_read_sample, read ccs811 TVOC and eCO2);
-#endif
-
-static int rt_hw_ccs811_port(void)
-{
-    struct rt_sensor_config cfg;
-    
-    cfg.intf.type = RT_SENSOR_INTF_I2C;
-    cfg.intf.dev_name = CCS811_I2C_BUS_NAME;
-    rt_hw_ccs811_init("cs8", &cfg);
-    
-    return RT_EOK;
-}
-INIT_COMPONENT_EXPORT(rt_hw_ccs811_port);
+/*
+ * Copyright (c) 2020, RudyLo <luhuadong@163.com>
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2020-06-21     luhuadong    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <board.h>
+#include "ccs811.h"
+
+#define CCS811_I2C_BUS_NAME       "i2c2"
+
+/* With nINT wired the sensor tells when a result is ready, else the framework samples it */
+#ifdef PKG_USING_CCS811_INT_PIN
+#define CCS811_OPEN_FLAG          RT_DEVICE_FLAG_INT_RX
+#else
+#define CCS811_OPEN_FLAG          RT_DEVICE_FLAG_FIFO_RX
+#endif
+
+static rt_sem_t ccs811_rx_sem = RT_NULL;
+
+static rt_err_t ccs811_rx_indicate(rt_device_t dev, rt_size_t size)
+{
+    rt_sem_release(ccs811_rx_sem);
+    return RT_EOK;
+}
+
+/* 
+ * The sensor framework samples both channels at 1 Hz and queues the data,
+ * or nINT reports each new result. This thread only sleeps until something
+ * arrives.
+ */
+static void read_ccs811_entry(void *args)
+{
+    rt_device_t tvoc_dev = RT_NULL, eco2_dev = RT_NULL;
+    struct rt_sensor_data sensor_data;
+
+    tvoc_dev = rt_device_find("tvoc_cs8");
+    eco2_dev = rt_device_find("eco2_cs8");
+    if (!tvoc_dev || !eco2_dev) 
+    {
+        rt_kprintf("Can't find TVOC or eCO2 device.\n");
+        return;
+    }
+
+    rt_device_set_rx_indicate(tvoc_dev, ccs811_rx_indicate);
+    rt_device_set_rx_indicate(eco2_dev, ccs811_rx_indicate);
+
+    if (rt_device_open(tvoc_dev, CCS811_OPEN_FLAG))
+    {
+        rt_kprintf("Open TVOC device failed.\n");
+        return;
+    }
+    if (rt_device_open(eco2_dev, CCS811_OPEN_FLAG))
+    {
+        rt_kprintf("Open eCO2 device failed.\n");
+        rt_device_close(tvoc_dev);
+        return;
+    }
+    rt_device_control(tvoc_dev, RT_SENSOR_CTRL_SET_ODR, (void *)1);
+    rt_device_control(eco2_dev, RT_SENSOR_CTRL_SET_ODR, (void *)1);
+
+    rt_uint16_t loop = 20;
+    while (loop--)
+    {
+        rt_sem_take(ccs811_rx_sem, RT_WAITING_FOREVER);
+
+        while (1 == rt_device_read(tvoc_dev, 0, &sensor_data, 1))
+        {
+            rt_kprintf("[%d] TVOC: %d\n", sensor_data.timestamp, sensor_data.data.tvoc);
+        }
+        while (1 == rt_device_read(eco2_dev, 0, &sensor_data, 1))
+        {
+            rt_kprintf("[%d] eCO2: %d%s\n", sensor_data.timestamp, sensor_data.data.eco2,
+                       (sensor_data.flags & RT_SENSOR_DATA_FLAG_EVENT) ? " (threshold crossed)" : "");
+        }
+    }
+
+    rt_device_close(eco2_dev);
+    rt_device_close(tvoc_dev);
+}
+
+static int ccs811_read_sample(void)
+{
+    rt_thread_t tid;
+
+    if (ccs811_rx_sem == RT_NULL)
+    {
+        ccs811_rx_sem = rt_sem_create("cs8_rx", 0, RT_IPC_FLAG_FIFO);
+        if (ccs811_rx_sem == RT_NULL)
+            return -RT_ENOMEM;
+    }
+
+    tid = rt_thread_create("ccs811_th", read_ccs811_entry, RT_NULL, 1024, 
+                           RT_THREAD_PRIORITY_MAX / 2, 20);
+    if (tid) 
+        rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+#ifdef FINSH_USING_MSH
+MSH_CMD_EXPORT(ccs811_read_sample, read ccs811 TVOC and eCO2);
+#endif
+
+static int rt_hw_ccs811_port(void)
+{
+    struct rt_sensor_config cfg;
+    
+    rt_memset(&cfg, 0, sizeof(cfg));
+    cfg.intf.type = RT_SENSOR_INTF_I2C;
+    cfg.intf.dev_name = CCS811_I2C_BUS_NAME;
+#ifdef PKG_USING_CCS811_INT_PIN
+    /* nINT is open drain and active low */
+    cfg.irq_pin.pin  = PKG_USING_CCS811_INT_PIN;
+    cfg.irq_pin.mode = PIN_MODE_INPUT_PULLUP;
+#else
+    cfg.irq_pin.pin = RT_PIN_NONE;
+#endif
+    rt_hw_ccs811_init("cs8", &cfg);
+    
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(rt_hw_ccs811_port);
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Checks the integer conversion kernels of the AHT10, BH1750 and CCS811
+ * drivers against a double precision reference over every raw value, and
+ * times them against the float conversion they replace. Returns non-zero
+ * on the first mismatch.
+ */
+
+#include <rtthread.h>
+#include <math.h>
+#include <time.h>
+
+#include "aht10.h"
+#include "bh1750.h"
+#include "ccs811.h"
+
+#define SIM_BENCH_LOOPS     (1 << 24)
+
+static int sim_convert_fails;
+
+static void sim_convert_check(const char *name, long raw, long value, double ref)
+{
+    /* Round half up like the kernels */
+    long expect = (long)floor(ref + 0.5);
+
+    if (value != expect && sim_convert_fails++ < 10)
+    {
+        rt_kprintf("%s: raw %ld gives %ld, expected %ld (%.6f)\n", name, raw, value, expect, ref);
+    }
+}
+
+static void sim_convert_golden(void)
+{
+    static const rt_uint8_t modes[] = {BH1750_CON_H_RES_MODE, BH1750_CON_H_RES_MODE2, BH1750_CON_L_RES_MODE};
+    static const rt_uint8_t mtregs[] = {31, BH1750_MTREG_DEFAULT, 254};
+    rt_uint8_t buf[6], env[4];
+    rt_uint32_t raw;
+    rt_int32_t t, h;
+    int m, r;
+
+    for (raw = 0; raw < (1 << 20); raw++)
+    {
+        sim_convert_check("aht10 temp", raw, aht10_temp_to_dcelsius(raw), raw * 2000.0 / (1 << 20) - 500);
+        sim_convert_check("aht10 humi", raw, aht10_humi_to_permillage(raw), raw * 1000.0 / (1 << 20));
+    }
+
+    /* The raw fields share byte 3 */
+    buf[0] = 0x1C;
+    buf[1] = 0x9A;
+    buf[2] = 0xBC;
+    buf[3] = 0xDE;
+    buf[4] = 0xF0;
+    buf[5] = 0x12;
+    if (aht10_humi_raw(buf) != 0x9ABCD || aht10_temp_raw(buf) != 0xEF012)
+    {
+        rt_kprintf("aht10: raw fields 0x%05x 0x%05x\n", aht10_humi_raw(buf), aht10_temp_raw(buf));
+        sim_convert_fails++;
+    }
+
+    for (m = 0; m < sizeof(modes); m++)
+    {
+        for (r = 0; r < sizeof(mtregs); r++)
+        {
+            for (raw = 0; raw <= 0xFFFF; raw++)
+            {
+                double ref = raw / 1.2 * BH1750_MTREG_DEFAULT / mtregs[r];
+
+                if (modes[m] == BH1750_CON_H_RES_MODE2)
+                    ref /= 2;
+                sim_convert_check("bh1750", raw, bh1750_raw_to_lux(raw, modes[m], mtregs[r]), ref);
+            }
+        }
+    }
+
+    /* ENV_DATA holds 0.5 steps of humidity and of temperature + 25 */
+    for (t = -250; t <= 1025; t++)
+    {
+        ccs811_envdata_encode(t, 500, env);
+        sim_convert_check("ccs811 temp", t, env[2], (t + 250) / 5.0);
+        sim_convert_check("ccs811 humi", t, env[0], 100);
+        if (env[1] != 0 || env[3] != 0)
+            sim_convert_fails++;
+    }
+    for (h = 0; h <= 1000; h++)
+    {
+        ccs811_envdata_encode(250, h, env);
+        sim_convert_check("ccs811 humi", h, env[0], h / 5.0);
+        sim_convert_check("ccs811 temp", h, env[2], 100);
+    }
+    ccs811_envdata_encode(-400, -10, env);
+    if (env[0] != 0 || env[2] != 0)
+        sim_convert_fails++;
+}
+
+static double sim_convert_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* The float conversions the drivers used before */
+static rt_int32_t sim_convert_aht10_float(rt_uint32_t raw)
+{
+    float temp = raw * 200.0 / (1 << 20) - 50;
+
+    return (rt_int32_t)(10 * temp);
+}
+
+static rt_int32_t sim_convert_bh1750_float(rt_uint16_t raw)
+{
+    return (rt_int32_t)((float)raw / 1.2);
+}
+
+static void sim_convert_bench(void)
+{
+    volatile rt_uint32_t sink = 0;
+    rt_uint32_t i;
+    double start, t_float, t_int;
+
+    start = sim_convert_now();
+    for (i = 0; i < SIM_BENCH_LOOPS; i++)
+        sink += sim_convert_aht10_float(i & 0xFFFFF);
+    t_float = sim_convert_now() - start;
+    start = sim_convert_now();
+    for (i = 0; i < SIM_BENCH_LOOPS; i++)
+        sink += aht10_temp_to_dcelsius(i & 0xFFFFF);
+    t_int = sim_convert_now() - start;
+    rt_kprintf("aht10 temp:  float %.2f ns, integer %.2f ns\n",
+               t_float * 1e9 / SIM_BENCH_LOOPS, t_int * 1e9 / SIM_BENCH_LOOPS);
+
+    start = sim_convert_now();
+    for (i = 0; i < SIM_BENCH_LOOPS; i++)
+        sink += sim_convert_bh1750_float(i);
+    t_float = sim_convert_now() - start;
+    start = sim_convert_now();
+    for (i = 0; i < SIM_BENCH_LOOPS; i++)
+        sink += bh1750_raw_to_lux(i, BH1750_CON_H_RES_MODE, BH1750_MTREG_DEFAULT);
+    t_int = sim_convert_now() - start;
+    rt_kprintf("bh1750 lux:  float %.2f ns, integer %.2f ns\n",
+               t_float * 1e9 / SIM_BENCH_LOOPS, t_int * 1e9 / SIM_BENCH_LOOPS);
+}
+
+int main(void)
+{
+    sim_convert_golden();
+    if (sim_convert_fails)
+    {
+        rt_kprintf("golden check: %d mismatches\n", sim_convert_fails);
+        return 1;
+    }
+    rt_kprintf("golden check: ok\n");
+
+    sim_convert_bench();
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Runs the AHT10, BH1750 and CCS811 drivers against the chip models on a
+ * mock i2c bus, then reads the AHT10 through the sensor framework.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <sim.h>
+
+#include "aht10.h"
+#include "bh1750.h"
+#include "ccs811.h"
+#include "sensor.h"
+
+#define SIM_I2C_BUS         "i2c1"
+#define SIM_I2C_HZ          100000
+#define SIM_CCS811_INT_PIN  42
+
+static aht10_device_t aht10;
+
+static rt_size_t sim_aht10_fetch_data(struct rt_sensor_device *sensor, void *buf, rt_size_t len)
+{
+    struct rt_sensor_data *data = (struct rt_sensor_data *)buf;
+
+    if (sensor->info.type == RT_SENSOR_CLASS_TEMP)
+        data->data.temp = (rt_int32_t)(10 * aht10_read_temperature(aht10));
+    else
+        data->data.humi = (rt_int32_t)(10 * aht10_read_humidity(aht10));
+    data->timestamp = rt_sensor_get_ts();
+
+    return 1;
+}
+
+static rt_err_t sim_aht10_control(struct rt_sensor_device *sensor, int cmd, void *args)
+{
+    /* Like the AHT10 glue: the chip cannot be put to sleep */
+    if (cmd == RT_SENSOR_CTRL_SET_POWER && ((rt_base_t)args & 0xFF) != RT_SENSOR_POWER_NORMAL)
+        return -RT_ENOSYS;
+
+    return RT_EOK;
+}
+
+static struct rt_sensor_ops sim_aht10_ops =
+{
+    sim_aht10_fetch_data,
+    sim_aht10_control
+};
+
+static rt_err_t sim_aht10_sensor_register(void)
+{
+    rt_sensor_t sensor;
+
+    sensor = rt_calloc(1, sizeof(struct rt_sensor_device));
+    if (sensor == RT_NULL)
+        return -RT_ENOMEM;
+
+    sensor->info.type       = RT_SENSOR_CLASS_TEMP;
+    sensor->info.vendor     = RT_SENSOR_VENDOR_UNKNOWN;
+    sensor->info.model      = "aht10";
+    sensor->info.unit       = RT_SENSOR_UNIT_DCELSIUS;
+    sensor->info.intf_type  = RT_SENSOR_INTF_I2C;
+    sensor->info.range_max  = 85;
+    sensor->info.range_min  = -40;
+    sensor->info.period_min = 5;
+    sensor->config.intf.dev_name = SIM_I2C_BUS;
+    sensor->config.irq_pin.pin = RT_PIN_NONE;
+    sensor->ops = &sim_aht10_ops;
+
+    return rt_hw_sensor_register(sensor, "aht10", RT_DEVICE_FLAG_RDONLY, RT_NULL);
+}
+
+static void sim_demo_chips(void)
+{
+    struct bh1750_device bh1750;
+    ccs811_device_t ccs811;
+    rt_uint64_t start;
+    rt_uint32_t lux = 0;
+    int i;
+
+    /* Only the first read waits for the conversion it starts, later reads return the one the previous read started */
+    start = sim_time_us();
+    rt_kprintf("aht10: %.2f C, ", aht10_read_temperature(aht10));
+    rt_kprintf("first read in %d us\n", (int)(sim_time_us() - start));
+    rt_thread_mdelay(100);
+    start = sim_time_us();
+    rt_kprintf("aht10: %.2f C, ", aht10_read_temperature(aht10));
+    rt_thread_mdelay(100);
+    rt_kprintf("%.2f %%RH\n", aht10_read_humidity(aht10));
+    rt_kprintf("aht10: %d us per read on the bus\n", (int)(sim_time_us() - start - 100000) / 2);
+
+    if (bh1750_init(&bh1750, SIM_I2C_BUS) == RT_EOK)
+    {
+        start = sim_time_us();
+        rt_kprintf("bh1750: %.1f lx, ", bh1750_read_light(&bh1750));
+        rt_kprintf("%d us per read\n", (int)(sim_time_us() - start));
+
+        /* The first continuous read waits for one measurement, the others only fetch the result */
+        bh1750_start_continuous(&bh1750, BH1750_CON_H_RES_MODE2);
+        bh1750_read_lux(&bh1750, &lux);
+        start = sim_time_us();
+        for (i = 0; i < 10; i++)
+        {
+            bh1750_read_lux(&bh1750, &lux);
+        }
+        rt_kprintf("bh1750: %d lx continuous, %d us per read\n", (int)lux, (int)(sim_time_us() - start) / 10);
+        bh1750_stop_continuous(&bh1750);
+    }
+
+    ccs811 = ccs811_create(SIM_I2C_BUS);
+    if (ccs811 != RT_NULL)
+    {
+        /* MODE_4 set by the driver only updates RAW_DATA, run the algorithm every second */
+        ccs811_set_measure_cycle(ccs811, CCS811_CYCLE_1S);
+        for (i = 0; i < 3; i++)
+        {
+            rt_thread_mdelay(1000);
+            if (ccs811_check_ready(ccs811) && ccs811_measure(ccs811))
+            {
+                rt_kprintf("ccs811: eCO2 %d ppm, TVOC %d ppb\n", ccs811->eCO2, ccs811->TVOC);
+            }
+        }
+        ccs811_delete(ccs811);
+    }
+}
+
+static void sim_demo_sensor(void)
+{
+    struct rt_sensor_data data;
+    rt_device_t dev;
+    int i;
+
+    dev = rt_device_find("temp_aht10");
+    if (dev == RT_NULL || rt_device_open(dev, RT_DEVICE_FLAG_RDONLY) != RT_EOK)
+    {
+        rt_kprintf("open temp_aht10 failed\n");
+        return;
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        if (rt_device_read(dev, 0, &data, 1) == 1)
+        {
+            rt_kprintf("temp_aht10: %d.%d C at %d ms\n", data.data.temp / 10, data.data.temp % 10, data.timestamp);
+        }
+        rt_thread_mdelay(100);
+    }
+    rt_device_close(dev);
+}
+
+int main(void)
+{
+    struct sim_env env;
+
+    rt_components_init();
+    rt_sensor_clock_register(sim_clock_read, 1000000);
+
+    if (sim_i2c_bus_create(SIM_I2C_BUS, SIM_I2C_HZ) == RT_NULL ||
+        sim_aht10_attach(SIM_I2C_BUS) != RT_EOK ||
+        sim_bh1750_attach(SIM_I2C_BUS, BH1750_ADDR) != RT_EOK ||
+        sim_ccs811_attach(SIM_I2C_BUS, CCS811_I2C_ADDRESS, SIM_CCS811_INT_PIN) != RT_EOK)
+    {
+        rt_kprintf("set up of the simulated board failed\n");
+        return -1;
+    }
+
+    sim_env_get(&env);
+    env.temp = 23.5;
+    env.humi = 41.0;
+    env.lux = 520.0;
+    env.eco2 = 612;
+    env.tvoc = 31;
+    sim_env_set(&env);
+
+    aht10 = aht10_init(SIM_I2C_BUS);
+    if (aht10 == RT_NULL)
+        return -1;
+
+    sim_demo_chips();
+
+    if (sim_aht10_sensor_register() == RT_EOK)
+    {
+        sim_demo_sensor();
+    }
+
+    aht10_deinit(aht10);
+
+    return 0;
+}
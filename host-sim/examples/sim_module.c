@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Reads temp_aht10 and humi_aht10 of the AHT10 glue in turn while the
+ * environment changes. Both members of a pair must come from the same
+ * measurement, and every pair must see the environment of its round: the
+ * conversion the previous pair started samples it when it finishes. Exits
+ * non-zero on a stale or mismatched partner sample.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <sim.h>
+
+#include "sensor.h"
+
+#define SIM_I2C_BUS         "i2c1"
+#define SIM_I2C_HZ          100000
+#define SIM_MODULE_ROUNDS   8
+
+/* The humidity tracks the temperature, so one pair tells whether both halves match */
+#define SIM_MODULE_HUMI_OFFSET  200     /* 20.0 %RH above the temperature */
+#define SIM_MODULE_PARTNER_DELAY_MS 20  /* Between the two reads of a round, within the module window */
+
+static int sim_module_check(void)
+{
+    struct rt_sensor_data temp, humi;
+    struct sim_env env;
+    rt_device_t dev_temp, dev_humi;
+    int i, errors = 0;
+
+    dev_temp = rt_device_find("temp_aht10");
+    dev_humi = rt_device_find("humi_aht10");
+    if (dev_temp == RT_NULL || dev_humi == RT_NULL ||
+        rt_device_open(dev_temp, RT_DEVICE_FLAG_RDONLY) != RT_EOK ||
+        rt_device_open(dev_humi, RT_DEVICE_FLAG_RDONLY) != RT_EOK)
+    {
+        rt_kprintf("open the aht10 module failed\n");
+        return 1;
+    }
+
+    for (i = 0; i < SIM_MODULE_ROUNDS; i++)
+    {
+        /* Every third round the temperature is read alone, its partner sample must not outlive the round */
+        if (i % 3 == 2)
+        {
+            rt_device_read(dev_temp, 0, &temp, 1);
+            rt_thread_mdelay(100);
+        }
+
+        sim_env_get(&env);
+        env.temp = 20.0 + i;
+        env.humi = env.temp + SIM_MODULE_HUMI_OFFSET / 10.0;
+        sim_env_set(&env);
+
+        /* Let the conversion started by the previous pair finish */
+        rt_thread_mdelay(100);
+
+        /*
+         * Alternate which member goes first, the other one takes the partner
+         * sample a little later, still within one measurement
+         */
+        if (i & 1)
+        {
+            rt_device_read(dev_humi, 0, &humi, 1);
+            rt_thread_mdelay(SIM_MODULE_PARTNER_DELAY_MS);
+            rt_device_read(dev_temp, 0, &temp, 1);
+        }
+        else
+        {
+            rt_device_read(dev_temp, 0, &temp, 1);
+            rt_thread_mdelay(SIM_MODULE_PARTNER_DELAY_MS);
+            rt_device_read(dev_humi, 0, &humi, 1);
+        }
+
+        rt_kprintf("round %d: %d.%d C, %d.%d %%RH, %d us apart\n", i,
+                   temp.data.temp / 10, temp.data.temp % 10, humi.data.humi / 10, humi.data.humi % 10,
+                   (int)(humi.timestamp_us - temp.timestamp_us));
+
+        if (temp.timestamp_us != humi.timestamp_us ||
+            humi.data.humi - temp.data.temp != SIM_MODULE_HUMI_OFFSET)
+        {
+            rt_kprintf("round %d: the pair comes from two measurements\n", i);
+            errors++;
+        }
+        if (temp.data.temp != 200 + 10 * i)
+        {
+            rt_kprintf("round %d: stale sample of %d.%d C\n", i, temp.data.temp / 10, temp.data.temp % 10);
+            errors++;
+        }
+    }
+
+    rt_device_close(dev_humi);
+    rt_device_close(dev_temp);
+
+    rt_kprintf("module check: %s\n", errors ? "FAILED" : "ok");
+    return errors ? 1 : 0;
+}
+
+int main(void)
+{
+    /* The glue registers the module from rt_components_init(), the bus must be there */
+    if (sim_i2c_bus_create(SIM_I2C_BUS, SIM_I2C_HZ) == RT_NULL ||
+        sim_aht10_attach(SIM_I2C_BUS) != RT_EOK)
+    {
+        rt_kprintf("set up of the simulated board failed\n");
+        return -1;
+    }
+
+    rt_components_init();
+    rt_sensor_clock_register(sim_clock_read, 1000000);
+
+    return sim_module_check();
+}
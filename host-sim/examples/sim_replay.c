@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Records ten minutes of a rising temperature read from the AHT10 model
+ * once a second, then plays the log back through a replay sensor at 60x
+ * and one record per read. Build with RT_SENSOR_USING_RECORD and the
+ * virtual time port, see README.md.
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <sim.h>
+
+#include "aht10.h"
+#include "sensor.h"
+
+#define SIM_I2C_BUS         "i2c1"
+#define SIM_I2C_HZ          100000
+
+#define SIM_RECORD_SECONDS  600
+#define SIM_LOG_SIZE        (sizeof(struct rt_sensor_record_header) + \
+                             (SIM_RECORD_SECONDS + 8) * sizeof(struct rt_sensor_sample))
+
+static aht10_device_t aht10;
+
+/* The log lives in memory, the shell command does the same to a file */
+static struct
+{
+    rt_uint8_t buf[SIM_LOG_SIZE];
+    rt_size_t  len;
+    rt_size_t  pos;
+} sim_log;
+
+static rt_size_t sim_log_write(const void *buf, rt_size_t size, void *user_data)
+{
+    if (size > sizeof(sim_log.buf) - sim_log.len)
+        size = sizeof(sim_log.buf) - sim_log.len;
+    rt_memcpy(sim_log.buf + sim_log.len, buf, size);
+    sim_log.len += size;
+
+    return size;
+}
+
+static rt_size_t sim_log_read(void *buf, rt_size_t size, void *user_data)
+{
+    if (size > sim_log.len - sim_log.pos)
+        size = sim_log.len - sim_log.pos;
+    rt_memcpy(buf, sim_log.buf + sim_log.pos, size);
+    sim_log.pos += size;
+
+    return size;
+}
+
+static rt_size_t sim_aht10_fetch_data(struct rt_sensor_device *sensor, void *buf, rt_size_t len)
+{
+    struct rt_sensor_data *data = (struct rt_sensor_data *)buf;
+
+    data->data.temp = (rt_int32_t)(10 * aht10_read_temperature(aht10));
+    data->timestamp = rt_sensor_get_ts();
+
+    return 1;
+}
+
+static rt_err_t sim_aht10_control(struct rt_sensor_device *sensor, int cmd, void *args)
+{
+    /* Like the AHT10 glue: the chip cannot be put to sleep */
+    if (cmd == RT_SENSOR_CTRL_SET_POWER && ((rt_base_t)args & 0xFF) != RT_SENSOR_POWER_NORMAL)
+        return -RT_ENOSYS;
+
+    return RT_EOK;
+}
+
+static struct rt_sensor_ops sim_aht10_ops =
+{
+    sim_aht10_fetch_data,
+    sim_aht10_control
+};
+
+static rt_err_t sim_aht10_sensor_register(void)
+{
+    rt_sensor_t sensor;
+
+    sensor = rt_calloc(1, sizeof(struct rt_sensor_device));
+    if (sensor == RT_NULL)
+        return -RT_ENOMEM;
+
+    sensor->info.type       = RT_SENSOR_CLASS_TEMP;
+    sensor->info.vendor     = RT_SENSOR_VENDOR_UNKNOWN;
+    sensor->info.model      = "aht10";
+    sensor->info.unit       = RT_SENSOR_UNIT_DCELSIUS;
+    sensor->info.intf_type  = RT_SENSOR_INTF_I2C;
+    sensor->info.range_max  = 85;
+    sensor->info.range_min  = -40;
+    sensor->info.period_min = 5;
+    sensor->config.intf.dev_name = SIM_I2C_BUS;
+    sensor->config.irq_pin.pin = RT_PIN_NONE;
+    sensor->ops = &sim_aht10_ops;
+
+    return rt_hw_sensor_register(sensor, "aht10", RT_DEVICE_FLAG_RDONLY, RT_NULL);
+}
+
+static int sim_record(void)
+{
+    struct rt_sensor_data data;
+    struct sim_env env;
+    rt_device_t dev;
+    int i;
+
+    dev = rt_device_find("temp_aht10");
+    if (dev == RT_NULL || rt_device_open(dev, RT_DEVICE_FLAG_RDONLY) != RT_EOK)
+        return -1;
+
+    /* The first read waits for a conversion of its own, keep it out of the log */
+    rt_device_read(dev, 0, &data, 1);
+    rt_thread_mdelay(1000);
+
+    rt_sensor_record_start(sim_log_write, RT_NULL);
+    sim_env_get(&env);
+    for (i = 0; i < SIM_RECORD_SECONDS; i++)
+    {
+        /* 20.0 C rising by 0.1 C every 10 s */
+        env.temp = 20.0 + (i / 10) * 0.1;
+        sim_env_set(&env);
+        rt_device_read(dev, 0, &data, 1);
+        rt_thread_mdelay(1000);
+    }
+    rt_sensor_record_stop();
+    rt_device_close(dev);
+
+    rt_kprintf("record: %d s, %d bytes\n", SIM_RECORD_SECONDS, (int)sim_log.len);
+
+    return 0;
+}
+
+static void sim_replay(const char *name, rt_uint16_t speed, int reads, rt_int32_t period_ms)
+{
+    struct rt_sensor_data data;
+    char dev_name[RT_NAME_MAX + 1];
+    rt_uint64_t start;
+    rt_device_t dev;
+    int i;
+
+    sim_log.pos = 0;
+    if (rt_hw_sensor_replay_init(name, RT_SENSOR_CLASS_TEMP, sim_log_read, RT_NULL, speed) != RT_EOK)
+        return;
+
+    rt_snprintf(dev_name, sizeof(dev_name), "temp_%s", name);
+    dev = rt_device_find(dev_name);
+    if (dev == RT_NULL || rt_device_open(dev, RT_DEVICE_FLAG_RDONLY) != RT_EOK)
+        return;
+
+    start = sim_time_us();
+    for (i = 0; i < reads; i++)
+    {
+        if (rt_device_read(dev, 0, &data, 1) == 1 && i % (reads / 5) == 0)
+        {
+            rt_kprintf("%s: %d.%d C at %d ms\n", dev_name, data.data.temp / 10, data.data.temp % 10,
+                       (int)((sim_time_us() - start) / 1000));
+        }
+        if (period_ms)
+            rt_thread_mdelay(period_ms);
+    }
+    rt_kprintf("%s: %d reads in %d ms\n", dev_name, reads, (int)((sim_time_us() - start) / 1000));
+    rt_device_close(dev);
+}
+
+int main(void)
+{
+    struct sim_env env;
+
+    rt_components_init();
+    rt_sensor_clock_register(sim_clock_read, 1000000);
+
+    if (sim_i2c_bus_create(SIM_I2C_BUS, SIM_I2C_HZ) == RT_NULL ||
+        sim_aht10_attach(SIM_I2C_BUS) != RT_EOK)
+    {
+        rt_kprintf("set up of the simulated board failed\n");
+        return -1;
+    }
+
+    sim_env_get(&env);
+    env.humi = 41.0;
+    sim_env_set(&env);
+
+    aht10 = aht10_init(SIM_I2C_BUS);
+    if (aht10 == RT_NULL || sim_aht10_sensor_register() != RT_EOK)
+        return -1;
+
+    if (sim_record() != 0)
+        return -1;
+
+    /* Ten minutes at 60x, read every 100 ms */
+    sim_replay("x60", 60, 100, 100);
+    /* Every record in turn, as fast as the reader goes */
+    sim_replay("x0", 0, SIM_RECORD_SECONDS, 0);
+
+    aht10_deinit(aht10);
+
+    return 0;
+}
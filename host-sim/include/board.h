@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+/* The simulated board has nothing beyond the mock I2C bus and pins of sim.h */
+#include <sim.h>
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* Configuration of the host simulation, mirrors the ls1cdev BSP */
+
+#define RT_NAME_MAX                 8
+#define RT_ALIGN_SIZE               4
+#define RT_THREAD_PRIORITY_MAX      32
+#define RT_TICK_PER_SECOND          1000
+
+#define RT_USING_DEVICE
+#define RT_USING_PIN
+#define RT_USING_I2C
+#define RT_USING_SENSOR
+#define RT_USING_IDLE_HOOK
+#define RT_IDLE_HOOK_LIST_SIZE      4
+#define RT_MAIN_THREAD_PRIORITY     10
+
+/* Packages */
+
+#define PKG_USING_AHT10
+#define PKG_USING_BH1750_LATEST_VERSION
+#define PKG_USING_CCS811
+#define PKG_USING_CCS811_I2C_ADDRESS 0x5A
+
+#endif
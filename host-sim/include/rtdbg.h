@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Log macros of RT-Thread, both the DBG_TAG/DBG_LVL and the older
+ * DBG_SECTION_NAME/DBG_LEVEL configuration are accepted.
+ */
+
+#ifndef RT_DBG_H__
+#define RT_DBG_H__
+
+#include <rtconfig.h>
+
+#define DBG_ERROR           0
+#define DBG_WARNING         1
+#define DBG_INFO            2
+#define DBG_LOG             3
+
+#if defined(DBG_TAG)
+#define DBG_SECTION_NAME_   DBG_TAG
+#elif defined(DBG_SECTION_NAME)
+#define DBG_SECTION_NAME_   DBG_SECTION_NAME
+#else
+#define DBG_SECTION_NAME_   "DBG"
+#endif
+
+#if defined(DBG_LVL)
+#define DBG_LEVEL_          DBG_LVL
+#elif defined(DBG_LEVEL)
+#define DBG_LEVEL_          DBG_LEVEL
+#else
+#define DBG_LEVEL_          DBG_WARNING
+#endif
+
+#define dbg_log_line(lvl, fmt, ...)                                 \
+    do                                                              \
+    {                                                               \
+        rt_kprintf("[" lvl "/%s] " fmt "\n", DBG_SECTION_NAME_, ##__VA_ARGS__); \
+    }                                                               \
+    while (0)
+
+#define dbg_log(level, ...)                                         \
+    if ((level) <= DBG_LEVEL_)                                      \
+    {                                                               \
+        rt_kprintf(__VA_ARGS__);                                    \
+    }
+
+#if (DBG_LEVEL_ >= DBG_LOG)
+#define LOG_D(fmt, ...)     dbg_log_line("D", fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(...)
+#endif
+
+#if (DBG_LEVEL_ >= DBG_INFO)
+#define LOG_I(fmt, ...)     dbg_log_line("I", fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(...)
+#endif
+
+#if (DBG_LEVEL_ >= DBG_WARNING)
+#define LOG_W(fmt, ...)     dbg_log_line("W", fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(...)
+#endif
+
+#if (DBG_LEVEL_ >= DBG_ERROR)
+#define LOG_E(fmt, ...)     dbg_log_line("E", fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(...)
+#endif
+
+#define LOG_RAW(...)        rt_kprintf(__VA_ARGS__)
+
+#endif /* RT_DBG_H__ */
@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The subset of the RT-Thread kernel API used by the sensor framework and
+ * the drivers, for building them on a PC. Types and signatures follow
+ * RT-Thread 4.0; the kernel objects are implemented in host-sim/port.
+ */
+
+#ifndef __RT_THREAD_H__
+#define __RT_THREAD_H__
+
+#include <rtconfig.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* basic data type definitions */
+
+typedef signed   char                   rt_int8_t;
+typedef signed   short                  rt_int16_t;
+typedef signed   int                    rt_int32_t;
+typedef signed   long long              rt_int64_t;
+typedef unsigned char                   rt_uint8_t;
+typedef unsigned short                  rt_uint16_t;
+typedef unsigned int                    rt_uint32_t;
+typedef unsigned long long              rt_uint64_t;
+typedef int                             rt_bool_t;
+typedef long                            rt_base_t;
+typedef unsigned long                   rt_ubase_t;
+
+typedef rt_base_t                       rt_err_t;
+typedef rt_uint32_t                     rt_time_t;
+typedef rt_uint32_t                     rt_tick_t;
+typedef rt_base_t                       rt_flag_t;
+typedef rt_ubase_t                      rt_size_t;
+typedef rt_ubase_t                      rt_dev_t;
+typedef rt_base_t                       rt_off_t;
+
+#define RT_TRUE                         1
+#define RT_FALSE                        0
+
+#define RT_UINT32_MAX                   0xffffffff
+#define RT_TICK_MAX                     RT_UINT32_MAX
+
+#define RT_NULL                         (0)
+
+#define rt_inline                       static __inline
+#define RT_UNUSED(x)                    ((void)(x))
+
+#define RT_ALIGN(size, align)           (((size) + (align) - 1) & ~((align) - 1))
+#define RT_ALIGN_DOWN(size, align)      ((size) & ~((align) - 1))
+
+/* error code definitions */
+
+#define RT_EOK                          0
+#define RT_ERROR                        1
+#define RT_ETIMEOUT                     2
+#define RT_EFULL                        3
+#define RT_EEMPTY                       4
+#define RT_ENOMEM                       5
+#define RT_ENOSYS                       6
+#define RT_EBUSY                        7
+#define RT_EIO                          8
+#define RT_EINTR                        9
+#define RT_EINVAL                       10
+
+#define RT_WAITING_FOREVER              -1
+#define RT_WAITING_NO                   0
+
+#define RT_IPC_FLAG_FIFO                0x00
+#define RT_IPC_FLAG_PRIO                0x01
+
+/* automatic initialization, run in level order by rt_components_init() */
+
+typedef int (*init_fn_t)(void);
+
+struct rt_init_desc
+{
+    const char      *level;
+    init_fn_t        fn;
+};
+
+#define INIT_EXPORT(fn, level)                                                      \
+    const struct rt_init_desc __rt_init_desc_##fn                                   \
+    __attribute__((used, section("rti_fn"), aligned(sizeof(void *)))) = { level, fn }
+
+#define INIT_BOARD_EXPORT(fn)           INIT_EXPORT(fn, "1")
+#define INIT_PREV_EXPORT(fn)            INIT_EXPORT(fn, "2")
+#define INIT_DEVICE_EXPORT(fn)          INIT_EXPORT(fn, "3")
+#define INIT_COMPONENT_EXPORT(fn)       INIT_EXPORT(fn, "4")
+#define INIT_ENV_EXPORT(fn)             INIT_EXPORT(fn, "5")
+#define INIT_APP_EXPORT(fn)             INIT_EXPORT(fn, "6")
+
+/* there is no shell on the host */
+#define MSH_CMD_EXPORT(command, desc)
+#define MSH_CMD_EXPORT_ALIAS(command, alias, desc)
+#define FINSH_FUNCTION_EXPORT(name, desc)
+
+#define RT_ASSERT(EX)                                                               \
+    if (!(EX))                                                                      \
+    {                                                                               \
+        rt_assert_handler(#EX, __FUNCTION__, __LINE__);                             \
+    }
+
+/* double list */
+
+struct rt_list_node
+{
+    struct rt_list_node *next;
+    struct rt_list_node *prev;
+};
+typedef struct rt_list_node rt_list_t;
+
+struct rt_slist_node
+{
+    struct rt_slist_node *next;
+};
+typedef struct rt_slist_node rt_slist_t;
+
+#define rt_container_of(ptr, type, member) \
+    ((type *)((char *)(ptr) - (unsigned long)(&((type *)0)->member)))
+
+#define RT_LIST_OBJECT_INIT(object) { &(object), &(object) }
+
+rt_inline void rt_list_init(rt_list_t *l)
+{
+    l->next = l->prev = l;
+}
+
+rt_inline void rt_list_insert_after(rt_list_t *l, rt_list_t *n)
+{
+    l->next->prev = n;
+    n->next = l->next;
+
+    l->next = n;
+    n->prev = l;
+}
+
+rt_inline void rt_list_insert_before(rt_list_t *l, rt_list_t *n)
+{
+    l->prev->next = n;
+    n->prev = l->prev;
+
+    l->prev = n;
+    n->next = l;
+}
+
+rt_inline void rt_list_remove(rt_list_t *n)
+{
+    n->next->prev = n->prev;
+    n->prev->next = n->next;
+
+    n->next = n->prev = n;
+}
+
+rt_inline int rt_list_isempty(const rt_list_t *l)
+{
+    return l->next == l;
+}
+
+rt_inline unsigned int rt_list_len(const rt_list_t *l)
+{
+    unsigned int len = 0;
+    const rt_list_t *p = l;
+    while (p->next != l)
+    {
+        p = p->next;
+        len ++;
+    }
+
+    return len;
+}
+
+#define rt_list_entry(node, type, member) \
+    rt_container_of(node, type, member)
+
+#define rt_list_for_each(pos, head) \
+    for (pos = (head)->next; pos != (head); pos = pos->next)
+
+#define rt_list_for_each_safe(pos, n, head) \
+    for (pos = (head)->next, n = pos->next; pos != (head); \
+        pos = n, n = pos->next)
+
+#define rt_list_for_each_entry(pos, head, member) \
+    for (pos = rt_list_entry((head)->next, typeof(*pos), member); \
+         &pos->member != (head); \
+         pos = rt_list_entry(pos->member.next, typeof(*pos), member))
+
+/* kernel objects */
+
+enum rt_object_class_type
+{
+    RT_Object_Class_Null   = 0,
+    RT_Object_Class_Thread,
+    RT_Object_Class_Semaphore,
+    RT_Object_Class_Mutex,
+    RT_Object_Class_Event,
+    RT_Object_Class_MailBox,
+    RT_Object_Class_MessageQueue,
+    RT_Object_Class_MemHeap,
+    RT_Object_Class_MemPool,
+    RT_Object_Class_Device,
+    RT_Object_Class_Timer,
+    RT_Object_Class_Module,
+    RT_Object_Class_Unknown,
+    RT_Object_Class_Static = 0x80
+};
+
+struct rt_object
+{
+    char       name[RT_NAME_MAX + 1];   /* One more than the kernel, so it is always NUL-terminated */
+    rt_uint8_t type;
+    rt_uint8_t flag;
+
+    rt_list_t  list;
+};
+typedef struct rt_object *rt_object_t;
+
+struct rt_object_information
+{
+    enum rt_object_class_type type;
+    rt_list_t                 object_list;
+    rt_size_t                 object_size;
+};
+
+/* the kernel objects keep their host implementation behind 'host' */
+
+#define RT_TIMER_FLAG_DEACTIVATED       0x0
+#define RT_TIMER_FLAG_ACTIVATED         0x1
+#define RT_TIMER_FLAG_ONE_SHOT          0x0
+#define RT_TIMER_FLAG_PERIODIC          0x2
+#define RT_TIMER_FLAG_HARD_TIMER        0x0
+#define RT_TIMER_FLAG_SOFT_TIMER        0x4
+
+#define RT_TIMER_CTRL_SET_TIME          0x0
+#define RT_TIMER_CTRL_GET_TIME          0x1
+#define RT_TIMER_CTRL_SET_ONESHOT       0x2
+#define RT_TIMER_CTRL_SET_PERIODIC      0x3
+
+struct rt_timer
+{
+    struct rt_object parent;
+
+    rt_list_t        row;
+    void (*timeout_func)(void *parameter);
+    void            *parameter;
+
+    rt_tick_t        init_tick;
+    rt_tick_t        timeout_tick;
+};
+typedef struct rt_timer *rt_timer_t;
+
+#define RT_THREAD_INIT                  0x00
+#define RT_THREAD_READY                 0x01
+#define RT_THREAD_SUSPEND               0x02
+#define RT_THREAD_RUNNING               0x03
+#define RT_THREAD_CLOSE                 0x04
+
+struct rt_thread
+{
+    char        name[RT_NAME_MAX + 1];
+    rt_uint8_t  type;
+    rt_uint8_t  flags;
+    rt_list_t   list;
+
+    void       *entry;
+    void       *parameter;
+    rt_uint32_t stack_size;
+    rt_uint8_t  init_priority;
+    rt_uint8_t  current_priority;
+    rt_uint8_t  stat;
+
+    rt_err_t    error;
+    void       *host;
+    rt_uint32_t user_data;
+};
+typedef struct rt_thread *rt_thread_t;
+
+struct rt_semaphore
+{
+    struct rt_object parent;
+
+    rt_uint16_t      value;
+    void            *host;
+};
+typedef struct rt_semaphore *rt_sem_t;
+
+struct rt_mutex
+{
+    struct rt_object parent;
+
+    rt_uint16_t      value;
+    rt_uint8_t       hold;
+    struct rt_thread *owner;
+    void            *host;
+};
+typedef struct rt_mutex *rt_mutex_t;
+
+/* kernel service */
+
+void rt_kprintf(const char *fmt, ...);
+rt_int32_t rt_snprintf(char *buf, rt_size_t size, const char *format, ...);
+rt_int32_t rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args);
+rt_int32_t rt_sprintf(char *buf, const char *format, ...);
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line);
+
+#define rt_memset       memset
+#define rt_memcpy       memcpy
+#define rt_memmove      memmove
+#define rt_memcmp       memcmp
+#define rt_strlen       strlen
+#define rt_strncpy      strncpy
+#define rt_strncmp      strncmp
+#define rt_strcmp       strcmp
+#define rt_strstr       strstr
+
+void *rt_malloc(rt_size_t size);
+void *rt_realloc(void *ptr, rt_size_t newsize);
+void *rt_calloc(rt_size_t count, rt_size_t size);
+void  rt_free(void *ptr);
+
+struct rt_object_information *rt_object_get_information(enum rt_object_class_type type);
+
+/* clock & timer */
+
+rt_tick_t rt_tick_get(void);
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms);
+
+rt_timer_t rt_timer_create(const char *name,
+                           void (*timeout)(void *parameter),
+                           void       *parameter,
+                           rt_tick_t   time,
+                           rt_uint8_t  flag);
+rt_err_t rt_timer_delete(rt_timer_t timer);
+rt_err_t rt_timer_start(rt_timer_t timer);
+rt_err_t rt_timer_stop(rt_timer_t timer);
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg);
+
+/* thread */
+
+rt_thread_t rt_thread_create(const char *name,
+                             void (*entry)(void *parameter),
+                             void       *parameter,
+                             rt_uint32_t stack_size,
+                             rt_uint8_t  priority,
+                             rt_uint32_t tick);
+rt_err_t rt_thread_delete(rt_thread_t thread);
+rt_err_t rt_thread_startup(rt_thread_t thread);
+rt_thread_t rt_thread_self(void);
+rt_thread_t rt_thread_find(char *name);
+rt_err_t rt_thread_yield(void);
+rt_err_t rt_thread_delay(rt_tick_t tick);
+rt_err_t rt_thread_mdelay(rt_int32_t ms);
+
+rt_err_t rt_thread_idle_sethook(void (*hook)(void));
+rt_err_t rt_thread_idle_delhook(void (*hook)(void));
+
+void rt_enter_critical(void);
+void rt_exit_critical(void);
+
+rt_uint8_t rt_interrupt_get_nest(void);
+void rt_interrupt_enter(void);
+void rt_interrupt_leave(void);
+
+/* IPC */
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag);
+rt_err_t rt_sem_delete(rt_sem_t sem);
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time);
+rt_err_t rt_sem_trytake(rt_sem_t sem);
+rt_err_t rt_sem_release(rt_sem_t sem);
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_delete(rt_mutex_t mutex);
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time);
+rt_err_t rt_mutex_release(rt_mutex_t mutex);
+
+/* device */
+
+#ifdef RT_USING_DEVICE
+
+enum rt_device_class_type
+{
+    RT_Device_Class_Char = 0,
+    RT_Device_Class_Block,
+    RT_Device_Class_NetIf,
+    RT_Device_Class_MTD,
+    RT_Device_Class_CAN,
+    RT_Device_Class_RTC,
+    RT_Device_Class_Sound,
+    RT_Device_Class_Graphic,
+    RT_Device_Class_I2CBUS,
+    RT_Device_Class_USBDevice,
+    RT_Device_Class_USBHost,
+    RT_Device_Class_SPIBUS,
+    RT_Device_Class_SPIDevice,
+    RT_Device_Class_SDIO,
+    RT_Device_Class_PM,
+    RT_Device_Class_Pipe,
+    RT_Device_Class_Portal,
+    RT_Device_Class_Timer,
+    RT_Device_Class_Miscellaneous,
+    RT_Device_Class_Sensor,
+    RT_Device_Class_Touch,
+    RT_Device_Class_Unknown
+};
+
+#define RT_DEVICE_FLAG_DEACTIVATE       0x000
+#define RT_DEVICE_FLAG_RDONLY           0x001
+#define RT_DEVICE_FLAG_WRONLY           0x002
+#define RT_DEVICE_FLAG_RDWR             0x003
+#define RT_DEVICE_FLAG_REMOVABLE        0x004
+#define RT_DEVICE_FLAG_STANDALONE       0x008
+#define RT_DEVICE_FLAG_ACTIVATED        0x010
+#define RT_DEVICE_FLAG_SUSPENDED        0x020
+#define RT_DEVICE_FLAG_STREAM           0x040
+#define RT_DEVICE_FLAG_INT_RX           0x100
+#define RT_DEVICE_FLAG_DMA_RX           0x200
+#define RT_DEVICE_FLAG_INT_TX           0x400
+#define RT_DEVICE_FLAG_DMA_TX           0x800
+
+#define RT_DEVICE_OFLAG_CLOSE           0x000
+#define RT_DEVICE_OFLAG_RDONLY          0x001
+#define RT_DEVICE_OFLAG_WRONLY          0x002
+#define RT_DEVICE_OFLAG_RDWR            0x003
+#define RT_DEVICE_OFLAG_OPEN            0x008
+#define RT_DEVICE_OFLAG_MASK            0xf0f
+
+typedef struct rt_device *rt_device_t;
+
+struct rt_device
+{
+    struct rt_object          parent;
+
+    enum rt_device_class_type type;
+    rt_uint16_t               flag;
+    rt_uint16_t               open_flag;
+
+    rt_uint8_t                ref_count;
+    rt_uint8_t                device_id;
+
+    rt_err_t (*rx_indicate)(rt_device_t dev, rt_size_t size);
+    rt_err_t (*tx_complete)(rt_device_t dev, void *buffer);
+
+    rt_err_t  (*init)   (rt_device_t dev);
+    rt_err_t  (*open)   (rt_device_t dev, rt_uint16_t oflag);
+    rt_err_t  (*close)  (rt_device_t dev);
+    rt_size_t (*read)   (rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size);
+    rt_size_t (*write)  (rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
+    rt_err_t  (*control)(rt_device_t dev, int cmd, void *args);
+
+    void                     *user_data;
+};
+
+rt_device_t rt_device_find(const char *name);
+rt_err_t rt_device_register(rt_device_t dev, const char *name, rt_uint16_t flags);
+rt_err_t rt_device_unregister(rt_device_t dev);
+rt_err_t rt_device_init(rt_device_t dev);
+rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag);
+rt_err_t rt_device_close(rt_device_t dev);
+rt_size_t rt_device_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size);
+rt_size_t rt_device_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg);
+rt_err_t rt_device_set_rx_indicate(rt_device_t dev, rt_err_t (*rx_ind)(rt_device_t dev, rt_size_t size));
+
+#endif /* RT_USING_DEVICE */
+
+/* run the INIT_xxx_EXPORT functions, called once by the simulation main() */
+int rt_components_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Host simulation of the board: the clock, interrupt pins, mock I2C buses
+ * and the register models of the sensor chips hanging off them.
+ */
+
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* clock, provided by the kernel port */
+
+rt_uint64_t sim_time_us(void);              /* Time since the start of the simulation */
+void        sim_delay_us(rt_uint32_t us);   /* Keep the calling thread busy, e.g. for a bus transfer */
+rt_uint32_t sim_clock_read(void);           /* 1 MHz counter for rt_sensor_clock_register() */
+
+/* objects */
+
+/* Name a kernel object, cut at RT_NAME_MAX characters like the kernel does and always NUL-terminated */
+void sim_name_copy(char name[RT_NAME_MAX + 1], const char *src);
+
+/* pins */
+
+#define SIM_PIN_MAX     128
+
+/* Drive an input pin from outside, an attached irq runs on the matching edge */
+void sim_pin_set(rt_base_t pin, rt_base_t value);
+
+/* i2c */
+
+/* A chip on a mock bus, 'write' and 'read' return -RT_EIO to NACK */
+struct sim_i2c_dev
+{
+    rt_list_t    list;
+    rt_uint16_t  addr;
+
+    rt_err_t (*write)(struct sim_i2c_dev *dev, const rt_uint8_t *buf, rt_size_t len);
+    rt_err_t (*read)(struct sim_i2c_dev *dev, rt_uint8_t *buf, rt_size_t len);
+    void        *user_data;
+};
+
+/* Register a mock bus, each transfer takes the bus time at 'hz' */
+struct rt_i2c_bus_device *sim_i2c_bus_create(const char *name, rt_uint32_t hz);
+rt_err_t sim_i2c_attach(struct rt_i2c_bus_device *bus, struct sim_i2c_dev *dev);
+void     sim_i2c_detach(struct sim_i2c_dev *dev);
+
+/* environment seen by the chip models */
+
+struct sim_env
+{
+    double       temp;      /* Temperature, unit: Celsius */
+    double       humi;      /* Relative humidity, unit: % */
+    double       lux;       /* Illuminance, unit: lux */
+    rt_uint16_t  eco2;      /* Equivalent CO2, unit: ppm */
+    rt_uint16_t  tvoc;      /* Total VOC, unit: ppb */
+};
+
+void sim_env_set(const struct sim_env *env);
+void sim_env_get(struct sim_env *env);
+
+/* chip models, attached to a bus registered with sim_i2c_bus_create() */
+
+rt_err_t sim_aht10_attach(const char *bus_name);
+rt_err_t sim_bh1750_attach(const char *bus_name, rt_uint16_t addr);
+rt_err_t sim_ccs811_attach(const char *bus_name, rt_uint16_t addr, rt_base_t int_pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_H__ */
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Register model of the ASAIR AHT10 humidity and temperature sensor.
+ *
+ * A write is a command byte followed by two parameter bytes, a read returns
+ * the status byte and the 20 bit humidity and temperature of the last
+ * finished conversion. A conversion takes 75 ms from the 0xAC trigger and
+ * samples the environment when it finishes.
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <sim.h>
+
+#define DBG_TAG               "sim.aht10"
+#define DBG_LVL               DBG_WARNING
+#include <rtdbg.h>
+
+#define AHT10_ADDR            0x38
+
+#define AHT10_CMD_CALIBRATION 0xE1
+#define AHT10_CMD_NORMAL      0xA8
+#define AHT10_CMD_MEASURE     0xAC
+#define AHT10_CMD_SOFT_RESET  0xBA
+
+#define AHT10_STATUS_BUSY     0x80
+#define AHT10_STATUS_MODE_POS 5
+#define AHT10_STATUS_CAL      0x08
+
+#define AHT10_MODE_NOR        0
+#define AHT10_MODE_CYC        1
+#define AHT10_MODE_CMD        2
+
+#define AHT10_CONVERT_US      75000
+
+struct sim_aht10
+{
+    struct sim_i2c_dev parent;
+
+    rt_uint8_t   mode;
+    rt_bool_t    calibrated;
+    rt_bool_t    busy;          /* A conversion is running */
+    rt_uint64_t  done_us;       /* When the running conversion finishes */
+    rt_uint32_t  humi_raw;      /* 20 bit results of the last conversion */
+    rt_uint32_t  temp_raw;
+};
+
+static rt_uint32_t sim_aht10_scale(double value, double offset, double span)
+{
+    double raw = (value + offset) / span * (1 << 20);
+
+    if (raw < 0)
+        return 0;
+    if (raw > (1 << 20) - 1)
+        return (1 << 20) - 1;
+
+    return (rt_uint32_t)raw;
+}
+
+/* Latch the result of a conversion that has finished by now */
+static void sim_aht10_update(struct sim_aht10 *chip)
+{
+    struct sim_env env;
+
+    if (!chip->busy || sim_time_us() < chip->done_us)
+        return;
+
+    sim_env_get(&env);
+    chip->humi_raw = sim_aht10_scale(env.humi, 0, 100);
+    chip->temp_raw = sim_aht10_scale(env.temp, 50, 200);
+    chip->busy = RT_FALSE;
+}
+
+static void sim_aht10_reset(struct sim_aht10 *chip)
+{
+    chip->mode = AHT10_MODE_NOR;
+    chip->calibrated = RT_FALSE;
+    chip->busy = RT_FALSE;
+    chip->humi_raw = 0;
+    chip->temp_raw = 0;
+}
+
+static rt_err_t sim_aht10_write(struct sim_i2c_dev *dev, const rt_uint8_t *buf, rt_size_t len)
+{
+    struct sim_aht10 *chip = (struct sim_aht10 *)dev;
+    rt_base_t level;
+
+    if (len == 0)
+        return RT_EOK;
+
+    level = rt_hw_interrupt_disable();
+    sim_aht10_update(chip);
+
+    switch (buf[0])
+    {
+    case AHT10_CMD_CALIBRATION:
+        /* Parameter 0x08 0x00 loads the calibration coefficients */
+        if (len >= 2 && (buf[1] & 0x08))
+        {
+            chip->calibrated = RT_TRUE;
+        }
+        break;
+
+    case AHT10_CMD_NORMAL:
+        chip->mode = AHT10_MODE_NOR;
+        break;
+
+    case AHT10_CMD_MEASURE:
+        /* A trigger while busy is ignored by the chip */
+        if (!chip->busy)
+        {
+            chip->busy = RT_TRUE;
+            chip->done_us = sim_time_us() + AHT10_CONVERT_US;
+        }
+        break;
+
+    case AHT10_CMD_SOFT_RESET:
+        sim_aht10_reset(chip);
+        break;
+
+    default:
+        LOG_W("unknown command 0x%02x", buf[0]);
+        break;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+static rt_err_t sim_aht10_read(struct sim_i2c_dev *dev, rt_uint8_t *buf, rt_size_t len)
+{
+    struct sim_aht10 *chip = (struct sim_aht10 *)dev;
+    rt_uint8_t data[6];
+    rt_base_t level;
+    rt_size_t i;
+
+    level = rt_hw_interrupt_disable();
+    sim_aht10_update(chip);
+
+    data[0] = (chip->busy ? AHT10_STATUS_BUSY : 0) |
+              (chip->mode << AHT10_STATUS_MODE_POS) |
+              (chip->calibrated ? AHT10_STATUS_CAL : 0);
+    data[1] = chip->humi_raw >> 12;
+    data[2] = chip->humi_raw >> 4;
+    data[3] = (chip->humi_raw & 0x0F) << 4 | (chip->temp_raw >> 16 & 0x0F);
+    data[4] = chip->temp_raw >> 8;
+    data[5] = chip->temp_raw;
+    rt_hw_interrupt_enable(level);
+
+    /* The chip keeps clocking out 0xFF past the data */
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = i < sizeof(data) ? data[i] : 0xFF;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function attaches an AHT10 model to a mock i2c bus.
+ *
+ * @param bus_name the name of the bus made by sim_i2c_bus_create()
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t sim_aht10_attach(const char *bus_name)
+{
+    struct rt_i2c_bus_device *bus;
+    struct sim_aht10 *chip;
+
+    bus = rt_i2c_bus_device_find(bus_name);
+    if (bus == RT_NULL)
+    {
+        LOG_E("Can't find bus '%s'", bus_name);
+        return -RT_ERROR;
+    }
+
+    chip = (struct sim_aht10 *)rt_calloc(1, sizeof(struct sim_aht10));
+    if (chip == RT_NULL)
+        return -RT_ENOMEM;
+
+    chip->parent.addr = AHT10_ADDR;
+    chip->parent.write = sim_aht10_write;
+    chip->parent.read = sim_aht10_read;
+    sim_aht10_reset(chip);
+
+    if (sim_i2c_attach(bus, &chip->parent) != RT_EOK)
+    {
+        rt_free(chip);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
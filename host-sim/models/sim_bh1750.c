@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Register model of the ROHM BH1750FVI ambient light sensor.
+ *
+ * Every write is a one byte opcode, a read returns the 16 bit data
+ * register. The measurement time scales with MTreg: 120 ms (H, H2) or
+ * 16 ms (L) at the default MTreg of 69. The count is lux * 1.2 * MTreg / 69,
+ * doubled in H-resolution mode 2 where the lsb is 0.5 lx.
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <sim.h>
+
+#define DBG_TAG                 "sim.bh1750"
+#define DBG_LVL                 DBG_WARNING
+#include <rtdbg.h>
+
+#define BH1750_OP_POWER_DOWN    0x00
+#define BH1750_OP_POWER_ON      0x01
+#define BH1750_OP_RESET         0x07
+#define BH1750_OP_CON_H         0x10
+#define BH1750_OP_CON_H2        0x11
+#define BH1750_OP_CON_L         0x13
+#define BH1750_OP_ONE_H         0x20
+#define BH1750_OP_ONE_H2        0x21
+#define BH1750_OP_ONE_L         0x23
+#define BH1750_OP_MT_HIGH       0x40    /* 01000_xxx, MTreg bit 7:5 */
+#define BH1750_OP_MT_LOW        0x60    /* 011_xxxxx, MTreg bit 4:0 */
+
+#define BH1750_MT_DEFAULT       69
+#define BH1750_MT_MIN           31
+#define BH1750_MT_MAX           254
+
+#define BH1750_H_US             120000
+#define BH1750_L_US             16000
+
+struct sim_bh1750
+{
+    struct sim_i2c_dev parent;
+
+    rt_bool_t    powered;
+    rt_uint8_t   mode;          /* Measurement opcode, 0 when idle */
+    rt_uint8_t   mtreg;
+    rt_uint64_t  done_us;       /* When the running measurement finishes */
+    rt_uint16_t  data;          /* Data register */
+};
+
+/* MTreg is written in two halves, a value outside the range acts as the limit */
+static rt_uint8_t sim_bh1750_mtreg(struct sim_bh1750 *chip)
+{
+    if (chip->mtreg < BH1750_MT_MIN)
+        return BH1750_MT_MIN;
+    if (chip->mtreg > BH1750_MT_MAX)
+        return BH1750_MT_MAX;
+
+    return chip->mtreg;
+}
+
+static rt_uint32_t sim_bh1750_time_us(struct sim_bh1750 *chip)
+{
+    rt_uint32_t base = ((chip->mode & 0x03) == 0x03) ? BH1750_L_US : BH1750_H_US;
+
+    return base * sim_bh1750_mtreg(chip) / BH1750_MT_DEFAULT;
+}
+
+static rt_uint16_t sim_bh1750_count(struct sim_bh1750 *chip)
+{
+    struct sim_env env;
+    double count;
+
+    sim_env_get(&env);
+    count = env.lux * 1.2 * sim_bh1750_mtreg(chip) / BH1750_MT_DEFAULT;
+    if ((chip->mode & 0x03) == 0x01)
+    {
+        count *= 2;
+    }
+    if (count > 0xFFFF)
+    {
+        count = 0xFFFF;
+    }
+    if (count < 0)
+    {
+        count = 0;
+    }
+
+    /* L-resolution has a 4 lx step, the two low bits stay 0 */
+    if ((chip->mode & 0x03) == 0x03)
+    {
+        return (rt_uint16_t)count & ~0x03;
+    }
+
+    return (rt_uint16_t)count;
+}
+
+/* Run the measurements that have finished by now */
+static void sim_bh1750_update(struct sim_bh1750 *chip)
+{
+    rt_uint64_t now = sim_time_us();
+    rt_uint32_t period;
+
+    if (chip->mode == 0 || now < chip->done_us)
+        return;
+
+    chip->data = sim_bh1750_count(chip);
+
+    if (chip->mode & 0x20)
+    {
+        /* One time modes drop to power down after the measurement */
+        chip->mode = 0;
+        chip->powered = RT_FALSE;
+    }
+    else
+    {
+        /* Continuous modes restart at once, skip the periods nobody read */
+        period = sim_bh1750_time_us(chip);
+        chip->done_us += (now - chip->done_us) / period * period + period;
+    }
+}
+
+static rt_err_t sim_bh1750_write(struct sim_i2c_dev *dev, const rt_uint8_t *buf, rt_size_t len)
+{
+    struct sim_bh1750 *chip = (struct sim_bh1750 *)dev;
+    rt_uint8_t op;
+    rt_base_t level;
+    rt_size_t i;
+
+    level = rt_hw_interrupt_disable();
+    sim_bh1750_update(chip);
+
+    for (i = 0; i < len; i++)
+    {
+        op = buf[i];
+
+        switch (op)
+        {
+        case BH1750_OP_POWER_DOWN:
+            chip->powered = RT_FALSE;
+            chip->mode = 0;
+            break;
+
+        case BH1750_OP_POWER_ON:
+            chip->powered = RT_TRUE;
+            break;
+
+        case BH1750_OP_RESET:
+            /* Reset is not accepted in power down */
+            if (chip->powered)
+            {
+                chip->data = 0;
+            }
+            break;
+
+        case BH1750_OP_CON_H:
+        case BH1750_OP_CON_H2:
+        case BH1750_OP_CON_L:
+        case BH1750_OP_ONE_H:
+        case BH1750_OP_ONE_H2:
+        case BH1750_OP_ONE_L:
+            chip->powered = RT_TRUE;
+            chip->mode = op;
+            chip->done_us = sim_time_us() + sim_bh1750_time_us(chip);
+            break;
+
+        default:
+            if ((op & 0xF8) == BH1750_OP_MT_HIGH)
+            {
+                chip->mtreg = (chip->mtreg & 0x1F) | (op & 0x07) << 5;
+            }
+            else if ((op & 0xE0) == BH1750_OP_MT_LOW)
+            {
+                chip->mtreg = (chip->mtreg & 0xE0) | (op & 0x1F);
+            }
+            else
+            {
+                LOG_W("unknown opcode 0x%02x", op);
+            }
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+static rt_err_t sim_bh1750_read(struct sim_i2c_dev *dev, rt_uint8_t *buf, rt_size_t len)
+{
+    struct sim_bh1750 *chip = (struct sim_bh1750 *)dev;
+    rt_uint16_t data;
+    rt_base_t level;
+    rt_size_t i;
+
+    level = rt_hw_interrupt_disable();
+    sim_bh1750_update(chip);
+    data = chip->data;
+    rt_hw_interrupt_enable(level);
+
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = (i == 0) ? data >> 8 : (i == 1) ? data & 0xFF : 0xFF;
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function attaches a BH1750 model to a mock i2c bus.
+ *
+ * @param bus_name the name of the bus made by sim_i2c_bus_create()
+ * @param addr 0x23 with ADDR low, 0x5C with ADDR high
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t sim_bh1750_attach(const char *bus_name, rt_uint16_t addr)
+{
+    struct rt_i2c_bus_device *bus;
+    struct sim_bh1750 *chip;
+
+    bus = rt_i2c_bus_device_find(bus_name);
+    if (bus == RT_NULL)
+    {
+        LOG_E("Can't find bus '%s'", bus_name);
+        return -RT_ERROR;
+    }
+
+    chip = (struct sim_bh1750 *)rt_calloc(1, sizeof(struct sim_bh1750));
+    if (chip == RT_NULL)
+        return -RT_ENOMEM;
+
+    chip->parent.addr = addr;
+    chip->parent.write = sim_bh1750_write;
+    chip->parent.read = sim_bh1750_read;
+    chip->mtreg = BH1750_MT_DEFAULT;
+
+    if (sim_i2c_attach(bus, &chip->parent) != RT_EOK)
+    {
+        rt_free(chip);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
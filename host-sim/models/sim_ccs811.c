@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Register model of the ams CCS811 gas sensor.
+ *
+ * The first byte of a write selects the mailbox and the rest is written to
+ * it, a read returns the selected mailbox. The chip starts in boot mode and
+ * enters the application with APP_START. In the application a measurement
+ * runs every 1 s, 10 s, 60 s or 250 ms depending on DRIVE_MODE; modes 1 to
+ * 3 update ALG_RESULT_DATA, mode 4 only RAW_DATA. nINT is driven low on new
+ * data when INT_DATARDY is set, and only on eCO2 band changes when
+ * INT_THRESH is set too.
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <sim.h>
+
+#define DBG_TAG                     "sim.ccs811"
+#define DBG_LVL                     DBG_WARNING
+#include <rtdbg.h>
+
+#define REG_STATUS                  0x00
+#define REG_MEAS_MODE               0x01
+#define REG_ALG_RESULT_DATA         0x02
+#define REG_RAW_DATA                0x03
+#define REG_ENV_DATA                0x05
+#define REG_THRESHOLDS              0x10
+#define REG_BASELINE                0x11
+#define REG_HW_ID                   0x20
+#define REG_HW_VERSION              0x21
+#define REG_FW_BOOT_VERSION         0x23
+#define REG_FW_APP_VERSION          0x24
+#define REG_ERROR_ID                0xE0
+#define REG_APP_START               0xF4
+#define REG_SW_RESET                0xFF
+
+#define STATUS_ERROR                0x01
+#define STATUS_DATA_READY           0x08
+#define STATUS_APP_VALID            0x10
+#define STATUS_FW_MODE              0x80
+
+#define MEAS_INT_THRESH             0x04
+#define MEAS_INT_DATARDY            0x08
+#define MEAS_DRIVE_MODE_POS         4
+
+#define ERROR_WRITE_REG_INVALID     0x01
+#define ERROR_READ_REG_INVALID      0x02
+#define ERROR_MEASMODE_INVALID      0x04
+
+#define HW_ID                       0x81
+#define HW_VERSION                  0x12
+#define FW_BOOT_VERSION             0x1000
+#define FW_APP_VERSION              0x2002
+
+#define START_US                    20000   /* from power on */
+#define RESET_US                    2000    /* from SW_RESET */
+#define APP_START_US                1000    /* from APP_START */
+
+#define THRESH_LOW_DEFAULT          1500
+#define THRESH_HIGH_DEFAULT         2500
+#define THRESH_HYST_DEFAULT         50
+
+struct sim_ccs811
+{
+    struct sim_i2c_dev parent;
+
+    rt_base_t    int_pin;       /* nINT, -1 when not wired */
+    rt_timer_t   timer;         /* Measurement cycle */
+    rt_uint64_t  ready_us;      /* The chip NACKs until then */
+
+    rt_uint8_t   mailbox;
+    rt_bool_t    app;           /* Application firmware running */
+    rt_uint8_t   status;
+    rt_uint8_t   meas_mode;
+    rt_uint8_t   error_id;
+
+    rt_uint16_t  eco2;
+    rt_uint16_t  tvoc;
+    rt_uint16_t  raw;
+    rt_uint8_t   env[4];
+    rt_uint16_t  thresh_low;
+    rt_uint16_t  thresh_high;
+    rt_uint8_t   thresh_hyst;
+    rt_uint8_t   band;          /* eCO2 band of the last interrupt, 0 low, 1 medium, 2 high */
+    rt_uint16_t  baseline;
+};
+
+static const rt_uint32_t sim_ccs811_period_ms[] = {0, 1000, 10000, 60000, 250};
+
+static void sim_ccs811_error(struct sim_ccs811 *chip, rt_uint8_t error)
+{
+    chip->error_id |= error;
+    chip->status |= STATUS_ERROR;
+}
+
+static void sim_ccs811_int(struct sim_ccs811 *chip, rt_base_t value)
+{
+    if (chip->int_pin >= 0)
+    {
+        sim_pin_set(chip->int_pin, value);
+    }
+}
+
+static rt_uint8_t sim_ccs811_band(struct sim_ccs811 *chip, rt_uint16_t eco2)
+{
+    rt_uint8_t band = chip->band;
+
+    /* Leave the current band only when past the boundary by the hysteresis */
+    if (band > 0 && eco2 + chip->thresh_hyst < chip->thresh_low)
+        band = 0;
+    else if (band > 1 && eco2 + chip->thresh_hyst < chip->thresh_high)
+        band = 1;
+    else if (band < 2 && eco2 > chip->thresh_high + chip->thresh_hyst)
+        band = 2;
+    else if (band < 1 && eco2 > chip->thresh_low + chip->thresh_hyst)
+        band = 1;
+
+    return band;
+}
+
+/* One measurement cycle, runs in the timer */
+static void sim_ccs811_measure(void *parameter)
+{
+    struct sim_ccs811 *chip = (struct sim_ccs811 *)parameter;
+    struct sim_env env;
+    rt_uint8_t drive = (chip->meas_mode >> MEAS_DRIVE_MODE_POS) & 0x07;
+    rt_uint8_t band;
+    rt_bool_t raise = RT_FALSE;
+    rt_base_t level;
+
+    sim_env_get(&env);
+
+    level = rt_hw_interrupt_disable();
+    /* 6 bit current in uA and 10 bit ADC reading, the more VOC the lower the resistance */
+    chip->raw = (32 << 10) | (1023 - (env.tvoc > 1023 ? 1023 : env.tvoc));
+
+    if (drive != 4)
+    {
+        chip->eco2 = env.eco2;
+        chip->tvoc = env.tvoc;
+        chip->status |= STATUS_DATA_READY;
+
+        if (chip->meas_mode & MEAS_INT_DATARDY)
+        {
+            if (chip->meas_mode & MEAS_INT_THRESH)
+            {
+                band = sim_ccs811_band(chip, chip->eco2);
+                raise = (band != chip->band);
+                chip->band = band;
+            }
+            else
+            {
+                raise = RT_TRUE;
+            }
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (raise)
+    {
+        sim_ccs811_int(chip, PIN_LOW);
+    }
+}
+
+static void sim_ccs811_set_mode(struct sim_ccs811 *chip, rt_uint8_t meas_mode)
+{
+    rt_uint8_t drive = (meas_mode >> MEAS_DRIVE_MODE_POS) & 0x07;
+    rt_tick_t tick;
+
+    if (drive > 4 || (meas_mode & 0x83))
+    {
+        sim_ccs811_error(chip, ERROR_MEASMODE_INVALID);
+        return;
+    }
+
+    if (drive != ((chip->meas_mode >> MEAS_DRIVE_MODE_POS) & 0x07))
+    {
+        rt_timer_stop(chip->timer);
+        if (drive != 0)
+        {
+            tick = rt_tick_from_millisecond(sim_ccs811_period_ms[drive]);
+            rt_timer_control(chip->timer, RT_TIMER_CTRL_SET_TIME, &tick);
+            rt_timer_start(chip->timer);
+        }
+    }
+    chip->meas_mode = meas_mode;
+
+    if (!(meas_mode & MEAS_INT_DATARDY))
+    {
+        sim_ccs811_int(chip, PIN_HIGH);
+    }
+}
+
+static void sim_ccs811_reset(struct sim_ccs811 *chip, rt_uint32_t boot_us)
+{
+    if (chip->timer != RT_NULL)
+    {
+        rt_timer_stop(chip->timer);
+    }
+
+    chip->ready_us = sim_time_us() + boot_us;
+    chip->mailbox = REG_STATUS;
+    chip->app = RT_FALSE;
+    chip->status = STATUS_APP_VALID;
+    chip->meas_mode = 0;
+    chip->error_id = 0;
+    chip->eco2 = 0;
+    chip->tvoc = 0;
+    chip->raw = 0;
+    chip->env[0] = 0x64;    /* 50 %RH */
+    chip->env[1] = 0x00;
+    chip->env[2] = 0x64;    /* 25 C */
+    chip->env[3] = 0x00;
+    chip->thresh_low = THRESH_LOW_DEFAULT;
+    chip->thresh_high = THRESH_HIGH_DEFAULT;
+    chip->thresh_hyst = THRESH_HYST_DEFAULT;
+    chip->band = 0;
+
+    sim_ccs811_int(chip, PIN_HIGH);
+}
+
+static void sim_ccs811_write_reg(struct sim_ccs811 *chip, const rt_uint8_t *data, rt_size_t len)
+{
+    static const rt_uint8_t reset_seq[4] = {0x11, 0xE5, 0x72, 0x8A};
+
+    switch (chip->mailbox)
+    {
+    case REG_SW_RESET:
+        if (len == 4 && rt_memcmp(data, reset_seq, 4) == 0)
+        {
+            sim_ccs811_reset(chip, RESET_US);
+        }
+        return;
+
+    case REG_APP_START:
+        /* A bare mailbox write, only valid in boot mode */
+        if (!chip->app && len == 0)
+        {
+            chip->app = RT_TRUE;
+            chip->status |= STATUS_FW_MODE;
+            chip->ready_us = sim_time_us() + APP_START_US;
+        }
+        return;
+    }
+
+    if (len == 0)
+        return;
+
+    if (!chip->app)
+    {
+        sim_ccs811_error(chip, ERROR_WRITE_REG_INVALID);
+        return;
+    }
+
+    switch (chip->mailbox)
+    {
+    case REG_MEAS_MODE:
+        sim_ccs811_set_mode(chip, data[0]);
+        break;
+
+    case REG_ENV_DATA:
+        if (len < 4)
+        {
+            sim_ccs811_error(chip, ERROR_WRITE_REG_INVALID);
+            break;
+        }
+        rt_memcpy(chip->env, data, 4);
+        break;
+
+    case REG_THRESHOLDS:
+        if (len < 4)
+        {
+            sim_ccs811_error(chip, ERROR_WRITE_REG_INVALID);
+            break;
+        }
+        chip->thresh_low = data[0] << 8 | data[1];
+        chip->thresh_high = data[2] << 8 | data[3];
+        chip->thresh_hyst = (len >= 5) ? data[4] : THRESH_HYST_DEFAULT;
+        break;
+
+    case REG_BASELINE:
+        if (len < 2)
+        {
+            sim_ccs811_error(chip, ERROR_WRITE_REG_INVALID);
+            break;
+        }
+        chip->baseline = data[0] << 8 | data[1];
+        break;
+
+    default:
+        sim_ccs811_error(chip, ERROR_WRITE_REG_INVALID);
+        break;
+    }
+}
+
+static rt_err_t sim_ccs811_write(struct sim_i2c_dev *dev, const rt_uint8_t *buf, rt_size_t len)
+{
+    struct sim_ccs811 *chip = (struct sim_ccs811 *)dev;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (sim_time_us() < chip->ready_us)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EIO;
+    }
+
+    if (len > 0)
+    {
+        chip->mailbox = buf[0];
+        sim_ccs811_write_reg(chip, buf + 1, len - 1);
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+static rt_err_t sim_ccs811_read(struct sim_i2c_dev *dev, rt_uint8_t *buf, rt_size_t len)
+{
+    struct sim_ccs811 *chip = (struct sim_ccs811 *)dev;
+    rt_uint8_t data[8];
+    rt_size_t size = 0, i;
+    rt_bool_t release = RT_FALSE;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (sim_time_us() < chip->ready_us)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EIO;
+    }
+
+    switch (chip->mailbox)
+    {
+    case REG_STATUS:
+        data[size++] = chip->status;
+        break;
+
+    case REG_HW_ID:
+        data[size++] = HW_ID;
+        break;
+
+    case REG_HW_VERSION:
+        data[size++] = HW_VERSION;
+        break;
+
+    case REG_FW_BOOT_VERSION:
+        data[size++] = FW_BOOT_VERSION >> 8;
+        data[size++] = FW_BOOT_VERSION & 0xFF;
+        break;
+
+    case REG_FW_APP_VERSION:
+        data[size++] = FW_APP_VERSION >> 8;
+        data[size++] = FW_APP_VERSION & 0xFF;
+        break;
+
+    case REG_ERROR_ID:
+        data[size++] = chip->error_id;
+        chip->error_id = 0;
+        chip->status &= ~STATUS_ERROR;
+        break;
+
+    default:
+        if (!chip->app)
+        {
+            sim_ccs811_error(chip, ERROR_READ_REG_INVALID);
+            break;
+        }
+
+        switch (chip->mailbox)
+        {
+        case REG_MEAS_MODE:
+            data[size++] = chip->meas_mode;
+            break;
+
+        case REG_ALG_RESULT_DATA:
+            data[size++] = chip->eco2 >> 8;
+            data[size++] = chip->eco2 & 0xFF;
+            data[size++] = chip->tvoc >> 8;
+            data[size++] = chip->tvoc & 0xFF;
+            data[size++] = chip->status;
+            data[size++] = chip->error_id;
+            data[size++] = chip->raw >> 8;
+            data[size++] = chip->raw & 0xFF;
+            /* Reading the results acknowledges them */
+            chip->status &= ~STATUS_DATA_READY;
+            release = RT_TRUE;
+            break;
+
+        case REG_RAW_DATA:
+            data[size++] = chip->raw >> 8;
+            data[size++] = chip->raw & 0xFF;
+            break;
+
+        case REG_BASELINE:
+            data[size++] = chip->baseline >> 8;
+            data[size++] = chip->baseline & 0xFF;
+            break;
+
+        default:
+            sim_ccs811_error(chip, ERROR_READ_REG_INVALID);
+            break;
+        }
+        break;
+    }
+    rt_hw_interrupt_enable(level);
+
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = i < size ? data[i] : 0x00;
+    }
+
+    if (release)
+    {
+        sim_ccs811_int(chip, PIN_HIGH);
+    }
+
+    return RT_EOK;
+}
+
+/**
+ * This function attaches a CCS811 model to a mock i2c bus.
+ *
+ * @param bus_name the name of the bus made by sim_i2c_bus_create()
+ * @param addr 0x5A with ADDR low, 0x5B with ADDR high
+ * @param int_pin the pin wired to nINT, -1 for none
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t sim_ccs811_attach(const char *bus_name, rt_uint16_t addr, rt_base_t int_pin)
+{
+    struct rt_i2c_bus_device *bus;
+    struct sim_ccs811 *chip;
+
+    bus = rt_i2c_bus_device_find(bus_name);
+    if (bus == RT_NULL)
+    {
+        LOG_E("Can't find bus '%s'", bus_name);
+        return -RT_ERROR;
+    }
+
+    chip = (struct sim_ccs811 *)rt_calloc(1, sizeof(struct sim_ccs811));
+    if (chip == RT_NULL)
+        return -RT_ENOMEM;
+
+    chip->parent.addr = addr;
+    chip->parent.write = sim_ccs811_write;
+    chip->parent.read = sim_ccs811_read;
+    chip->int_pin = int_pin;
+    chip->baseline = 0x847B;
+
+    chip->timer = rt_timer_create("ccs811", sim_ccs811_measure, chip,
+                                  RT_TICK_PER_SECOND, RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_SOFT_TIMER);
+    if (chip->timer == RT_NULL)
+    {
+        rt_free(chip);
+        return -RT_ENOMEM;
+    }
+    sim_ccs811_reset(chip, START_US);
+
+    if (sim_i2c_attach(bus, &chip->parent) != RT_EOK)
+    {
+        rt_timer_delete(chip->timer);
+        rt_free(chip);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
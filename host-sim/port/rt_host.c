@@ -0,0 +1,714 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Kernel port on POSIX threads in real time. Every rt_thread is a pthread,
+ * so the threads run in parallel and priorities are not honoured; the
+ * interrupt lock of rthw.h serialises the critical sections.
+ */
+
+#define _GNU_SOURCE
+#include <rtthread.h>
+#include <rthw.h>
+#include <sim.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+struct host_thread
+{
+    pthread_t        tid;
+    void (*entry)(void *parameter);
+    void            *parameter;
+};
+
+struct host_sem
+{
+    pthread_mutex_t  lock;
+    pthread_cond_t   cond;
+    rt_uint32_t      count;
+};
+
+static pthread_mutex_t host_irq_lock;
+static pthread_once_t  host_once = PTHREAD_ONCE_INIT;
+static struct timespec host_start;
+
+static __thread struct rt_thread *host_self = RT_NULL;
+static __thread rt_uint8_t        host_nest = 0;
+
+static struct rt_object_information host_thread_info =
+{
+    RT_Object_Class_Thread, RT_LIST_OBJECT_INIT(host_thread_info.object_list), sizeof(struct rt_thread)
+};
+static struct rt_object_information host_null_info =
+{
+    RT_Object_Class_Null, RT_LIST_OBJECT_INIT(host_null_info.object_list), 0
+};
+
+static void host_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&host_irq_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    clock_gettime(CLOCK_MONOTONIC, &host_start);
+}
+
+/* Absolute CLOCK_MONOTONIC deadline 'tick' ticks from now */
+static void host_deadline(struct timespec *ts, rt_int32_t tick)
+{
+    rt_uint64_t ns;
+
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    ns = (rt_uint64_t)ts->tv_nsec + (rt_uint64_t)tick * (1000000000 / RT_TICK_PER_SECOND);
+    ts->tv_sec += ns / 1000000000;
+    ts->tv_nsec = ns % 1000000000;
+}
+
+/* Clock */
+
+rt_uint64_t sim_time_us(void)
+{
+    struct timespec now;
+
+    pthread_once(&host_once, host_init);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (rt_uint64_t)(now.tv_sec - host_start.tv_sec) * 1000000 +
+           (now.tv_nsec - host_start.tv_nsec) / 1000;
+}
+
+/* A bus transfer keeps the CPU busy on the target, so spin instead of sleeping */
+void sim_delay_us(rt_uint32_t us)
+{
+    rt_uint64_t end = sim_time_us() + us;
+
+    while (sim_time_us() < end)
+        ;
+}
+
+rt_uint32_t sim_clock_read(void)
+{
+    return (rt_uint32_t)sim_time_us();
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    return (rt_tick_t)(sim_time_us() * RT_TICK_PER_SECOND / 1000000);
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    rt_tick_t tick;
+
+    if (ms < 0)
+    {
+        tick = (rt_tick_t)RT_WAITING_FOREVER;
+    }
+    else
+    {
+        tick = RT_TICK_PER_SECOND * (ms / 1000);
+        tick += (RT_TICK_PER_SECOND * (ms % 1000) + 999) / 1000;
+    }
+
+    return tick;
+}
+
+/* Interrupts */
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    pthread_once(&host_once, host_init);
+    pthread_mutex_lock(&host_irq_lock);
+
+    return 0;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    pthread_mutex_unlock(&host_irq_lock);
+}
+
+void rt_interrupt_enter(void)
+{
+    host_nest++;
+}
+
+void rt_interrupt_leave(void)
+{
+    host_nest--;
+}
+
+rt_uint8_t rt_interrupt_get_nest(void)
+{
+    return host_nest;
+}
+
+void rt_enter_critical(void)
+{
+    rt_hw_interrupt_disable();
+}
+
+void rt_exit_critical(void)
+{
+    rt_hw_interrupt_enable(0);
+}
+
+struct rt_object_information *rt_object_get_information(enum rt_object_class_type type)
+{
+    if (type == RT_Object_Class_Thread)
+        return &host_thread_info;
+
+    return &host_null_info;
+}
+
+/* Thread */
+
+static void host_thread_register(struct rt_thread *thread)
+{
+    rt_base_t level;
+
+    thread->type = RT_Object_Class_Thread;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_insert_before(&host_thread_info.object_list, &thread->list);
+    rt_hw_interrupt_enable(level);
+}
+
+static void host_thread_unregister(struct rt_thread *thread)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&thread->list);
+    rt_hw_interrupt_enable(level);
+}
+
+static void *host_thread_entry(void *arg)
+{
+    struct rt_thread *thread = (struct rt_thread *)arg;
+    struct host_thread *ht = (struct host_thread *)thread->host;
+
+    host_self = thread;
+    ht->entry(ht->parameter);
+    host_thread_unregister(thread);
+
+    return RT_NULL;
+}
+
+rt_thread_t rt_thread_create(const char *name,
+                             void (*entry)(void *parameter),
+                             void       *parameter,
+                             rt_uint32_t stack_size,
+                             rt_uint8_t  priority,
+                             rt_uint32_t tick)
+{
+    struct rt_thread *thread;
+    struct host_thread *ht;
+
+    thread = (struct rt_thread *)rt_calloc(1, sizeof(struct rt_thread));
+    ht = (struct host_thread *)rt_calloc(1, sizeof(struct host_thread));
+    if (thread == RT_NULL || ht == RT_NULL)
+    {
+        rt_free(thread);
+        rt_free(ht);
+        return RT_NULL;
+    }
+
+    ht->entry = entry;
+    ht->parameter = parameter;
+    thread->host = ht;
+    thread->entry = (void *)entry;
+    thread->parameter = parameter;
+    thread->stack_size = stack_size;
+    thread->init_priority = priority;
+    thread->current_priority = priority;
+    sim_name_copy(thread->name, name);
+
+    return thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    struct host_thread *ht = (struct host_thread *)thread->host;
+
+    host_thread_register(thread);
+    if (pthread_create(&ht->tid, RT_NULL, host_thread_entry, thread) != 0)
+    {
+        host_thread_unregister(thread);
+        return -RT_ERROR;
+    }
+    pthread_detach(ht->tid);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delete(rt_thread_t thread)
+{
+    struct host_thread *ht = (struct host_thread *)thread->host;
+
+    host_thread_unregister(thread);
+    if (thread == host_self)
+    {
+        pthread_exit(RT_NULL);
+    }
+    pthread_cancel(ht->tid);
+
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    static struct rt_thread main_thread;
+
+    if (host_self == RT_NULL)
+    {
+        /* The first thread asking is the one running main() */
+        if (main_thread.type == 0)
+        {
+            sim_name_copy(main_thread.name, "main");
+            host_thread_register(&main_thread);
+        }
+        host_self = &main_thread;
+    }
+
+    return host_self;
+}
+
+rt_thread_t rt_thread_find(char *name)
+{
+    rt_thread_t thread = RT_NULL;
+    rt_list_t *node;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_for_each(node, &host_thread_info.object_list)
+    {
+        rt_thread_t t = rt_list_entry(node, struct rt_thread, list);
+
+        if (rt_strncmp(t->name, name, RT_NAME_MAX) == 0)
+        {
+            thread = t;
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return thread;
+}
+
+rt_err_t rt_thread_yield(void)
+{
+    sched_yield();
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick)
+{
+    struct timespec ts;
+
+    host_deadline(&ts, tick);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, RT_NULL) == EINTR)
+        ;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms)
+{
+    return rt_thread_delay(rt_tick_from_millisecond(ms));
+}
+
+/* The host has no idle thread, the hooks are accepted and never called */
+rt_err_t rt_thread_idle_sethook(void (*hook)(void))
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_idle_delhook(void (*hook)(void))
+{
+    return RT_EOK;
+}
+
+/* Semaphore */
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    struct rt_semaphore *sem;
+    struct host_sem *hs;
+    pthread_condattr_t attr;
+
+    sem = (struct rt_semaphore *)rt_calloc(1, sizeof(struct rt_semaphore));
+    hs = (struct host_sem *)rt_calloc(1, sizeof(struct host_sem));
+    if (sem == RT_NULL || hs == RT_NULL)
+    {
+        rt_free(sem);
+        rt_free(hs);
+        return RT_NULL;
+    }
+
+    pthread_mutex_init(&hs->lock, RT_NULL);
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&hs->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    hs->count = value;
+
+    sim_name_copy(sem->parent.name, name);
+    sem->parent.type = RT_Object_Class_Semaphore;
+    sem->value = value;
+    sem->host = hs;
+
+    return sem;
+}
+
+rt_err_t rt_sem_delete(rt_sem_t sem)
+{
+    struct host_sem *hs = (struct host_sem *)sem->host;
+
+    pthread_cond_destroy(&hs->cond);
+    pthread_mutex_destroy(&hs->lock);
+    rt_free(hs);
+    rt_free(sem);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    struct host_sem *hs = (struct host_sem *)sem->host;
+    struct timespec ts;
+    rt_err_t result = RT_EOK;
+
+    if (time > 0)
+    {
+        host_deadline(&ts, time);
+    }
+
+    pthread_mutex_lock(&hs->lock);
+    while (hs->count == 0 && result == RT_EOK)
+    {
+        if (time == 0)
+            result = -RT_ETIMEOUT;
+        else if (time < 0)
+            pthread_cond_wait(&hs->cond, &hs->lock);
+        else if (pthread_cond_timedwait(&hs->cond, &hs->lock, &ts) == ETIMEDOUT)
+            result = -RT_ETIMEOUT;
+    }
+    if (result == RT_EOK)
+    {
+        hs->count--;
+    }
+    sem->value = hs->count;
+    pthread_mutex_unlock(&hs->lock);
+
+    return result;
+}
+
+rt_err_t rt_sem_trytake(rt_sem_t sem)
+{
+    return rt_sem_take(sem, 0);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    struct host_sem *hs = (struct host_sem *)sem->host;
+
+    pthread_mutex_lock(&hs->lock);
+    if (hs->count < 0xFFFF)
+    {
+        hs->count++;
+    }
+    sem->value = hs->count;
+    pthread_cond_signal(&hs->cond);
+    pthread_mutex_unlock(&hs->lock);
+
+    return RT_EOK;
+}
+
+/* Mutex, recursive like the RT-Thread one */
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
+{
+    struct rt_mutex *mutex;
+    pthread_mutex_t *pm;
+    pthread_mutexattr_t attr;
+
+    mutex = (struct rt_mutex *)rt_calloc(1, sizeof(struct rt_mutex));
+    pm = (pthread_mutex_t *)rt_calloc(1, sizeof(pthread_mutex_t));
+    if (mutex == RT_NULL || pm == RT_NULL)
+    {
+        rt_free(mutex);
+        rt_free(pm);
+        return RT_NULL;
+    }
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(pm, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    sim_name_copy(mutex->parent.name, name);
+    mutex->parent.type = RT_Object_Class_Mutex;
+    mutex->value = 1;
+    mutex->host = pm;
+
+    return mutex;
+}
+
+rt_err_t rt_mutex_delete(rt_mutex_t mutex)
+{
+    pthread_mutex_destroy((pthread_mutex_t *)mutex->host);
+    rt_free(mutex->host);
+    rt_free(mutex);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    pthread_mutex_t *pm = (pthread_mutex_t *)mutex->host;
+    struct timespec ts;
+    rt_uint64_t ns;
+
+    if (time < 0)
+    {
+        pthread_mutex_lock(pm);
+    }
+    else if (time == 0)
+    {
+        if (pthread_mutex_trylock(pm) != 0)
+            return -RT_ETIMEOUT;
+    }
+    else
+    {
+        /* pthread_mutex_timedlock() counts on CLOCK_REALTIME */
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ns = (rt_uint64_t)ts.tv_nsec + (rt_uint64_t)time * (1000000000 / RT_TICK_PER_SECOND);
+        ts.tv_sec += ns / 1000000000;
+        ts.tv_nsec = ns % 1000000000;
+        if (pthread_mutex_timedlock(pm, &ts) != 0)
+            return -RT_ETIMEOUT;
+    }
+
+    mutex->owner = rt_thread_self();
+    mutex->hold++;
+    mutex->value = 0;
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    pthread_mutex_t *pm = (pthread_mutex_t *)mutex->host;
+
+    if (mutex->owner != rt_thread_self())
+        return -RT_ERROR;
+
+    if (--mutex->hold == 0)
+    {
+        mutex->owner = RT_NULL;
+        mutex->value = 1;
+    }
+    pthread_mutex_unlock(pm);
+
+    return RT_EOK;
+}
+
+/*
+ * Timer. One host thread runs the callbacks of every rt_timer in timeout
+ * order; a hard timer callback runs in interrupt context.
+ */
+static rt_list_t       host_timer_list = RT_LIST_OBJECT_INIT(host_timer_list);
+static pthread_mutex_t host_timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  host_timer_cond;
+static pthread_t       host_timer_tid;
+static int             host_timer_started = 0;
+
+static void host_timer_insert(struct rt_timer *timer)
+{
+    rt_list_t *node;
+
+    rt_list_for_each(node, &host_timer_list)
+    {
+        struct rt_timer *t = rt_list_entry(node, struct rt_timer, row);
+
+        if ((rt_int32_t)(timer->timeout_tick - t->timeout_tick) < 0)
+            break;
+    }
+    rt_list_insert_before(node, &timer->row);
+}
+
+static void *host_timer_entry(void *arg)
+{
+    static struct rt_thread timer_thread;
+    struct rt_timer *timer;
+    struct timespec ts;
+    rt_int32_t wait;
+
+    sim_name_copy(timer_thread.name, "timer");
+    host_thread_register(&timer_thread);
+    host_self = &timer_thread;
+
+    pthread_mutex_lock(&host_timer_lock);
+    while (1)
+    {
+        if (rt_list_isempty(&host_timer_list))
+        {
+            pthread_cond_wait(&host_timer_cond, &host_timer_lock);
+            continue;
+        }
+
+        timer = rt_list_entry(host_timer_list.next, struct rt_timer, row);
+        wait = (rt_int32_t)(timer->timeout_tick - rt_tick_get());
+        if (wait > 0)
+        {
+            host_deadline(&ts, wait);
+            pthread_cond_timedwait(&host_timer_cond, &host_timer_lock, &ts);
+            continue;
+        }
+
+        rt_list_remove(&timer->row);
+        if (timer->parent.flag & RT_TIMER_FLAG_PERIODIC)
+        {
+            timer->timeout_tick += timer->init_tick;
+            host_timer_insert(timer);
+        }
+        else
+        {
+            timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        }
+        pthread_mutex_unlock(&host_timer_lock);
+
+        if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
+        {
+            timer->timeout_func(timer->parameter);
+        }
+        else
+        {
+            rt_base_t level = rt_hw_interrupt_disable();
+            rt_interrupt_enter();
+            timer->timeout_func(timer->parameter);
+            rt_interrupt_leave();
+            rt_hw_interrupt_enable(level);
+        }
+
+        pthread_mutex_lock(&host_timer_lock);
+    }
+
+    return RT_NULL;
+}
+
+rt_timer_t rt_timer_create(const char *name,
+                           void (*timeout)(void *parameter),
+                           void       *parameter,
+                           rt_tick_t   time,
+                           rt_uint8_t  flag)
+{
+    struct rt_timer *timer;
+    pthread_condattr_t attr;
+
+    pthread_mutex_lock(&host_timer_lock);
+    if (!host_timer_started)
+    {
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&host_timer_cond, &attr);
+        pthread_condattr_destroy(&attr);
+        if (pthread_create(&host_timer_tid, RT_NULL, host_timer_entry, RT_NULL) != 0)
+        {
+            pthread_mutex_unlock(&host_timer_lock);
+            return RT_NULL;
+        }
+        pthread_detach(host_timer_tid);
+        host_timer_started = 1;
+    }
+    pthread_mutex_unlock(&host_timer_lock);
+
+    timer = (struct rt_timer *)rt_calloc(1, sizeof(struct rt_timer));
+    if (timer == RT_NULL)
+        return RT_NULL;
+
+    sim_name_copy(timer->parent.name, name);
+    timer->parent.type = RT_Object_Class_Timer;
+    timer->parent.flag = flag & ~RT_TIMER_FLAG_ACTIVATED;
+    rt_list_init(&timer->row);
+    timer->timeout_func = timeout;
+    timer->parameter = parameter;
+    timer->init_tick = time;
+
+    return timer;
+}
+
+rt_err_t rt_timer_delete(rt_timer_t timer)
+{
+    rt_timer_stop(timer);
+    rt_free(timer);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer)
+{
+    pthread_mutex_lock(&host_timer_lock);
+    rt_list_remove(&timer->row);
+    timer->timeout_tick = rt_tick_get() + timer->init_tick;
+    timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
+    host_timer_insert(timer);
+    pthread_cond_signal(&host_timer_cond);
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer)
+{
+    pthread_mutex_lock(&host_timer_lock);
+    if (!(timer->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+    {
+        pthread_mutex_unlock(&host_timer_lock);
+        return -RT_ERROR;
+    }
+    rt_list_remove(&timer->row);
+    timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg)
+{
+    pthread_mutex_lock(&host_timer_lock);
+    switch (cmd)
+    {
+    case RT_TIMER_CTRL_GET_TIME:
+        *(rt_tick_t *)arg = timer->init_tick;
+        break;
+    case RT_TIMER_CTRL_SET_TIME:
+        timer->init_tick = *(rt_tick_t *)arg;
+        break;
+    case RT_TIMER_CTRL_SET_ONESHOT:
+        timer->parent.flag &= ~RT_TIMER_FLAG_PERIODIC;
+        break;
+    case RT_TIMER_CTRL_SET_PERIODIC:
+        timer->parent.flag |= RT_TIMER_FLAG_PERIODIC;
+        break;
+    }
+    pthread_mutex_unlock(&host_timer_lock);
+
+    return RT_EOK;
+}
@@ -0,0 +1,937 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Kernel port on a discrete-event virtual clock, an alternative to
+ * rt_host.c. Every rt_thread is still a pthread, but only the thread the
+ * scheduler picked runs, the others wait on their condition variable.
+ * The scheduler follows RT-Thread: the highest priority ready thread runs,
+ * a thread becoming ready preempts a lower priority one, equal priorities
+ * round-robin on yield only.
+ *
+ * Code takes no virtual time, only sim_delay_us() advances the clock while
+ * a thread runs. When no thread is ready the clock jumps to the next timer,
+ * so a sleep of any length costs nothing and a run is deterministic. A
+ * thread spinning on rt_tick_get() never sees the tick move.
+ */
+
+#define _GNU_SOURCE
+#include <rtthread.h>
+#include <rthw.h>
+#include <sim.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#define VT_US_PER_TICK      (1000000 / RT_TICK_PER_SECOND)
+
+struct vt_thread
+{
+    pthread_t        tid;
+    pthread_cond_t   cond;          /* Signalled when the thread is scheduled */
+    struct rt_thread *thread;
+
+    void (*entry)(void *parameter);
+    void            *parameter;
+
+    rt_list_t        tlist;         /* Node of a ready queue or an IPC wait list */
+    struct rt_timer  timer;         /* Timeout of a sleep or an IPC wait */
+};
+
+/* The running thread holds the kernel lock, waiting threads do not */
+static pthread_mutex_t   vt_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t    vt_once = PTHREAD_ONCE_INIT;
+
+static struct vt_thread *vt_current = RT_NULL;
+static rt_list_t         vt_ready[RT_THREAD_PRIORITY_MAX];
+static rt_list_t         vt_timer_list = RT_LIST_OBJECT_INIT(vt_timer_list);
+static rt_uint64_t       vt_now_us;
+
+static rt_uint8_t        vt_irq_nest;       /* rt_interrupt_enter() depth */
+static rt_uint32_t       vt_irq_disable;    /* rt_hw_interrupt_disable() depth */
+static rt_uint32_t       vt_critical;       /* rt_enter_critical() depth */
+static rt_bool_t         vt_need_resched;
+
+static void (*vt_idle_hook[RT_IDLE_HOOK_LIST_SIZE])(void);
+
+static struct rt_object_information vt_thread_info =
+{
+    RT_Object_Class_Thread, RT_LIST_OBJECT_INIT(vt_thread_info.object_list), sizeof(struct rt_thread)
+};
+static struct rt_object_information vt_null_info =
+{
+    RT_Object_Class_Null, RT_LIST_OBJECT_INIT(vt_null_info.object_list), 0
+};
+
+static __thread struct vt_thread *vt_self = RT_NULL;
+
+static void vt_thread_timeout(void *parameter);
+
+static void vt_thread_init(struct vt_thread *vt, struct rt_thread *thread)
+{
+    pthread_cond_init(&vt->cond, RT_NULL);
+    rt_list_init(&vt->tlist);
+    sim_name_copy(vt->timer.parent.name, thread->name);
+    vt->timer.parent.type = RT_Object_Class_Timer;
+    rt_list_init(&vt->timer.row);
+    vt->timer.timeout_func = vt_thread_timeout;
+    vt->timer.parameter = vt;
+    vt->thread = thread;
+    thread->host = vt;
+
+    thread->type = RT_Object_Class_Thread;
+    rt_list_insert_before(&vt_thread_info.object_list, &thread->list);
+}
+
+static void vt_init(void)
+{
+    static struct rt_thread main_thread;
+    static struct vt_thread main_vt;
+    int i;
+
+    for (i = 0; i < RT_THREAD_PRIORITY_MAX; i++)
+    {
+        rt_list_init(&vt_ready[i]);
+    }
+
+    /* The thread running main() becomes the main thread */
+    sim_name_copy(main_thread.name, "main");
+    main_thread.init_priority = RT_MAIN_THREAD_PRIORITY;
+    main_thread.current_priority = RT_MAIN_THREAD_PRIORITY;
+    main_thread.stat = RT_THREAD_READY;
+    vt_thread_init(&main_vt, &main_thread);
+    rt_list_insert_before(&vt_ready[RT_MAIN_THREAD_PRIORITY], &main_vt.tlist);
+
+    main_vt.tid = pthread_self();
+    vt_self = &main_vt;
+    vt_current = &main_vt;
+    pthread_mutex_lock(&vt_lock);
+}
+
+/* Every entry point makes sure the kernel is up, the first caller is main */
+#define VT_ENTER()      pthread_once(&vt_once, vt_init)
+
+/* Timer list, shared by rt_timer and the thread timeouts */
+
+static void vt_timer_insert(struct rt_timer *timer)
+{
+    rt_list_t *node;
+
+    /* Behind the timers with the same timeout, so equal timeouts fire in start order */
+    rt_list_for_each(node, &vt_timer_list)
+    {
+        struct rt_timer *t = rt_list_entry(node, struct rt_timer, row);
+
+        if ((rt_int32_t)(timer->timeout_tick - t->timeout_tick) < 0)
+            break;
+    }
+    rt_list_insert_before(node, &timer->row);
+}
+
+static void vt_timer_start(struct rt_timer *timer)
+{
+    rt_list_remove(&timer->row);
+    timer->timeout_tick = (rt_tick_t)(vt_now_us / VT_US_PER_TICK) + timer->init_tick;
+    timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
+    vt_timer_insert(timer);
+}
+
+static void vt_timer_stop(struct rt_timer *timer)
+{
+    rt_list_remove(&timer->row);
+    timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+}
+
+/*
+ * Fire the first timer if it is due by 'limit_us', moving the clock to its
+ * timeout. The callback runs in interrupt context, soft timers included.
+ */
+static rt_bool_t vt_timer_fire(rt_uint64_t limit_us)
+{
+    struct rt_timer *timer;
+    rt_uint64_t when;
+
+    if (rt_list_isempty(&vt_timer_list))
+        return RT_FALSE;
+
+    timer = rt_list_entry(vt_timer_list.next, struct rt_timer, row);
+    when = (rt_uint64_t)timer->timeout_tick * VT_US_PER_TICK;
+    if (when > limit_us)
+        return RT_FALSE;
+
+    if (when > vt_now_us)
+    {
+        vt_now_us = when;
+    }
+
+    rt_list_remove(&timer->row);
+    if (timer->parent.flag & RT_TIMER_FLAG_PERIODIC)
+    {
+        timer->timeout_tick += timer->init_tick ? timer->init_tick : 1;
+        vt_timer_insert(timer);
+    }
+    else
+    {
+        timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+    }
+
+    vt_irq_nest++;
+    timer->timeout_func(timer->parameter);
+    vt_irq_nest--;
+
+    return RT_TRUE;
+}
+
+/* Scheduler */
+
+static struct vt_thread *vt_highest_ready(void)
+{
+    int i;
+
+    for (i = 0; i < RT_THREAD_PRIORITY_MAX; i++)
+    {
+        if (!rt_list_isempty(&vt_ready[i]))
+        {
+            return rt_list_entry(vt_ready[i].next, struct vt_thread, tlist);
+        }
+    }
+
+    return RT_NULL;
+}
+
+static void vt_make_ready(struct vt_thread *vt)
+{
+    rt_list_remove(&vt->tlist);
+    vt->thread->stat = RT_THREAD_READY;
+    rt_list_insert_before(&vt_ready[vt->thread->current_priority], &vt->tlist);
+}
+
+static void vt_idle(void)
+{
+    int i;
+
+    for (i = 0; i < RT_IDLE_HOOK_LIST_SIZE; i++)
+    {
+        if (vt_idle_hook[i] != RT_NULL)
+        {
+            vt_idle_hook[i]();
+        }
+    }
+}
+
+/* Pick the next thread, advancing the clock while there is none */
+static struct vt_thread *vt_pick(void)
+{
+    struct vt_thread *to;
+
+    while ((to = vt_highest_ready()) == RT_NULL)
+    {
+        vt_idle();
+
+        if (!vt_timer_fire((rt_uint64_t)-1))
+        {
+            rt_kprintf("vtime: every thread waits forever at %llu us\n", (unsigned long long)vt_now_us);
+            exit(1);
+        }
+    }
+
+    return to;
+}
+
+/* Hand the CPU to 'to' and wait until 'self' is scheduled again */
+static void vt_switch(struct vt_thread *self, struct vt_thread *to)
+{
+    if (to != self)
+    {
+        vt_current = to;
+        pthread_cond_signal(&to->cond);
+    }
+
+    while (vt_current != self && self->thread->stat != RT_THREAD_CLOSE)
+    {
+        pthread_cond_wait(&self->cond, &vt_lock);
+    }
+
+    if (self->thread->stat == RT_THREAD_CLOSE)
+    {
+        /* Deleted by another thread while waiting */
+        pthread_mutex_unlock(&vt_lock);
+        pthread_exit(RT_NULL);
+    }
+}
+
+static void vt_schedule(void)
+{
+    if (vt_irq_nest || vt_irq_disable || vt_critical)
+    {
+        vt_need_resched = RT_TRUE;
+        return;
+    }
+    vt_need_resched = RT_FALSE;
+
+    vt_switch(vt_self, vt_pick());
+}
+
+/* Suspend the running thread on 'list' for up to 'time' ticks */
+static rt_err_t vt_suspend(rt_list_t *list, rt_uint8_t flag, rt_int32_t time)
+{
+    struct vt_thread *self = vt_self;
+    rt_list_t *node;
+
+    rt_list_remove(&self->tlist);
+    self->thread->stat = RT_THREAD_SUSPEND;
+    self->thread->error = RT_EOK;
+
+    if (list != RT_NULL)
+    {
+        node = list;
+        if (flag == RT_IPC_FLAG_PRIO)
+        {
+            rt_list_for_each(node, list)
+            {
+                struct vt_thread *t = rt_list_entry(node, struct vt_thread, tlist);
+
+                if (self->thread->current_priority < t->thread->current_priority)
+                    break;
+            }
+        }
+        rt_list_insert_before(node, &self->tlist);
+    }
+
+    if (time > 0)
+    {
+        self->timer.init_tick = time;
+        vt_timer_start(&self->timer);
+    }
+
+    vt_schedule();
+
+    return self->thread->error;
+}
+
+/* Wake the first waiter of an IPC wait list */
+static void vt_resume_first(rt_list_t *list)
+{
+    struct vt_thread *vt = rt_list_entry(list->next, struct vt_thread, tlist);
+
+    vt_timer_stop(&vt->timer);
+    vt_make_ready(vt);
+}
+
+static void vt_thread_timeout(void *parameter)
+{
+    struct vt_thread *vt = (struct vt_thread *)parameter;
+
+    vt->thread->error = -RT_ETIMEOUT;
+    vt_make_ready(vt);
+    vt_schedule();
+}
+
+/* Clock */
+
+rt_uint64_t sim_time_us(void)
+{
+    VT_ENTER();
+
+    return vt_now_us;
+}
+
+/* A busy wait: the clock moves on, the timers due meanwhile fire as interrupts */
+void sim_delay_us(rt_uint32_t us)
+{
+    rt_uint64_t end;
+
+    VT_ENTER();
+
+    end = vt_now_us + us;
+    while (vt_timer_fire(end))
+        ;
+    vt_now_us = end;
+
+    if (vt_need_resched)
+    {
+        vt_schedule();
+    }
+}
+
+rt_uint32_t sim_clock_read(void)
+{
+    return (rt_uint32_t)sim_time_us();
+}
+
+rt_tick_t rt_tick_get(void)
+{
+    VT_ENTER();
+
+    return (rt_tick_t)(vt_now_us / VT_US_PER_TICK);
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
+{
+    rt_tick_t tick;
+
+    if (ms < 0)
+    {
+        tick = (rt_tick_t)RT_WAITING_FOREVER;
+    }
+    else
+    {
+        tick = RT_TICK_PER_SECOND * (ms / 1000);
+        tick += (RT_TICK_PER_SECOND * (ms % 1000) + 999) / 1000;
+    }
+
+    return tick;
+}
+
+/* Interrupts, only the running thread executes so they just defer preemption */
+
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    VT_ENTER();
+
+    return vt_irq_disable++;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    vt_irq_disable = level;
+    if (vt_irq_disable == 0 && vt_need_resched)
+    {
+        vt_schedule();
+    }
+}
+
+void rt_interrupt_enter(void)
+{
+    vt_irq_nest++;
+}
+
+void rt_interrupt_leave(void)
+{
+    vt_irq_nest--;
+    if (vt_irq_nest == 0 && vt_need_resched)
+    {
+        vt_schedule();
+    }
+}
+
+rt_uint8_t rt_interrupt_get_nest(void)
+{
+    return vt_irq_nest;
+}
+
+void rt_enter_critical(void)
+{
+    VT_ENTER();
+    vt_critical++;
+}
+
+void rt_exit_critical(void)
+{
+    vt_critical--;
+    if (vt_critical == 0 && vt_need_resched)
+    {
+        vt_schedule();
+    }
+}
+
+struct rt_object_information *rt_object_get_information(enum rt_object_class_type type)
+{
+    VT_ENTER();
+
+    if (type == RT_Object_Class_Thread)
+        return &vt_thread_info;
+
+    return &vt_null_info;
+}
+
+/* Thread */
+
+static void vt_thread_exit(struct vt_thread *self)
+{
+    struct vt_thread *to;
+
+    vt_timer_stop(&self->timer);
+    rt_list_remove(&self->tlist);
+    rt_list_remove(&self->thread->list);
+    self->thread->stat = RT_THREAD_CLOSE;
+
+    to = vt_pick();
+    vt_current = to;
+    pthread_cond_signal(&to->cond);
+    pthread_mutex_unlock(&vt_lock);
+}
+
+static void *vt_thread_entry(void *arg)
+{
+    struct vt_thread *self = (struct vt_thread *)arg;
+
+    vt_self = self;
+    pthread_mutex_lock(&vt_lock);
+    vt_switch(self, self);
+
+    self->entry(self->parameter);
+
+    vt_thread_exit(self);
+
+    return RT_NULL;
+}
+
+rt_thread_t rt_thread_create(const char *name,
+                             void (*entry)(void *parameter),
+                             void       *parameter,
+                             rt_uint32_t stack_size,
+                             rt_uint8_t  priority,
+                             rt_uint32_t tick)
+{
+    struct rt_thread *thread;
+    struct vt_thread *vt;
+
+    VT_ENTER();
+    RT_ASSERT(priority < RT_THREAD_PRIORITY_MAX);
+
+    thread = (struct rt_thread *)rt_calloc(1, sizeof(struct rt_thread));
+    vt = (struct vt_thread *)rt_calloc(1, sizeof(struct vt_thread));
+    if (thread == RT_NULL || vt == RT_NULL)
+    {
+        rt_free(thread);
+        rt_free(vt);
+        return RT_NULL;
+    }
+
+    sim_name_copy(thread->name, name);
+    thread->entry = (void *)entry;
+    thread->parameter = parameter;
+    thread->stack_size = stack_size;
+    thread->init_priority = priority;
+    thread->current_priority = priority;
+    thread->stat = RT_THREAD_INIT;
+    vt->entry = entry;
+    vt->parameter = parameter;
+    vt_thread_init(vt, thread);
+
+    return thread;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread)
+{
+    struct vt_thread *vt = (struct vt_thread *)thread->host;
+
+    VT_ENTER();
+
+    if (pthread_create(&vt->tid, RT_NULL, vt_thread_entry, vt) != 0)
+        return -RT_ERROR;
+    pthread_detach(vt->tid);
+
+    vt_make_ready(vt);
+    vt_schedule();
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delete(rt_thread_t thread)
+{
+    struct vt_thread *vt = (struct vt_thread *)thread->host;
+
+    VT_ENTER();
+
+    if (vt == vt_self)
+    {
+        vt_thread_exit(vt);
+        pthread_exit(RT_NULL);
+    }
+
+    vt_timer_stop(&vt->timer);
+    rt_list_remove(&vt->tlist);
+    rt_list_remove(&thread->list);
+    thread->stat = RT_THREAD_CLOSE;
+
+    /* It exits once it gets the kernel lock */
+    pthread_cond_signal(&vt->cond);
+
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_self(void)
+{
+    VT_ENTER();
+
+    return vt_self ? vt_self->thread : RT_NULL;
+}
+
+rt_thread_t rt_thread_find(char *name)
+{
+    rt_list_t *node;
+
+    VT_ENTER();
+
+    rt_list_for_each(node, &vt_thread_info.object_list)
+    {
+        rt_thread_t t = rt_list_entry(node, struct rt_thread, list);
+
+        if (rt_strncmp(t->name, name, RT_NAME_MAX) == 0)
+            return t;
+    }
+
+    return RT_NULL;
+}
+
+rt_err_t rt_thread_yield(void)
+{
+    VT_ENTER();
+
+    /* To the tail of its priority */
+    vt_make_ready(vt_self);
+    vt_schedule();
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick)
+{
+    VT_ENTER();
+
+    if (tick == 0)
+        return rt_thread_yield();
+
+    vt_suspend(RT_NULL, RT_IPC_FLAG_FIFO, tick);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms)
+{
+    return rt_thread_delay(rt_tick_from_millisecond(ms));
+}
+
+rt_err_t rt_thread_idle_sethook(void (*hook)(void))
+{
+    int i;
+
+    VT_ENTER();
+
+    for (i = 0; i < RT_IDLE_HOOK_LIST_SIZE; i++)
+    {
+        if (vt_idle_hook[i] == RT_NULL)
+        {
+            vt_idle_hook[i] = hook;
+            return RT_EOK;
+        }
+    }
+
+    return -RT_EFULL;
+}
+
+rt_err_t rt_thread_idle_delhook(void (*hook)(void))
+{
+    int i;
+
+    VT_ENTER();
+
+    for (i = 0; i < RT_IDLE_HOOK_LIST_SIZE; i++)
+    {
+        if (vt_idle_hook[i] == hook)
+        {
+            vt_idle_hook[i] = RT_NULL;
+            return RT_EOK;
+        }
+    }
+
+    return -RT_ENOSYS;
+}
+
+/* Semaphore */
+
+struct vt_ipc
+{
+    rt_list_t        suspend;       /* Waiting threads */
+    rt_uint8_t       flag;
+};
+
+rt_sem_t rt_sem_create(const char *name, rt_uint32_t value, rt_uint8_t flag)
+{
+    struct rt_semaphore *sem;
+    struct vt_ipc *ipc;
+
+    VT_ENTER();
+
+    sem = (struct rt_semaphore *)rt_calloc(1, sizeof(struct rt_semaphore));
+    ipc = (struct vt_ipc *)rt_calloc(1, sizeof(struct vt_ipc));
+    if (sem == RT_NULL || ipc == RT_NULL)
+    {
+        rt_free(sem);
+        rt_free(ipc);
+        return RT_NULL;
+    }
+
+    rt_list_init(&ipc->suspend);
+    ipc->flag = flag;
+    sim_name_copy(sem->parent.name, name);
+    sem->parent.type = RT_Object_Class_Semaphore;
+    sem->value = value;
+    sem->host = ipc;
+
+    return sem;
+}
+
+rt_err_t rt_sem_delete(rt_sem_t sem)
+{
+    struct vt_ipc *ipc = (struct vt_ipc *)sem->host;
+
+    VT_ENTER();
+
+    /* The waiters get an error like on the target */
+    while (!rt_list_isempty(&ipc->suspend))
+    {
+        rt_list_entry(ipc->suspend.next, struct vt_thread, tlist)->thread->error = -RT_ERROR;
+        vt_resume_first(&ipc->suspend);
+    }
+    rt_free(ipc);
+    rt_free(sem);
+    vt_schedule();
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
+{
+    struct vt_ipc *ipc = (struct vt_ipc *)sem->host;
+
+    VT_ENTER();
+
+    if (sem->value > 0)
+    {
+        sem->value--;
+        return RT_EOK;
+    }
+
+    if (time == 0)
+        return -RT_ETIMEOUT;
+
+    /* A release hands the count over to the thread it wakes */
+    return vt_suspend(&ipc->suspend, ipc->flag, time);
+}
+
+rt_err_t rt_sem_trytake(rt_sem_t sem)
+{
+    return rt_sem_take(sem, 0);
+}
+
+rt_err_t rt_sem_release(rt_sem_t sem)
+{
+    struct vt_ipc *ipc = (struct vt_ipc *)sem->host;
+
+    VT_ENTER();
+
+    if (!rt_list_isempty(&ipc->suspend))
+    {
+        vt_resume_first(&ipc->suspend);
+        vt_schedule();
+    }
+    else if (sem->value < 0xFFFF)
+    {
+        sem->value++;
+    }
+    else
+    {
+        return -RT_EFULL;
+    }
+
+    return RT_EOK;
+}
+
+/* Mutex, recursive; without priority inheritance */
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
+{
+    struct rt_mutex *mutex;
+    struct vt_ipc *ipc;
+
+    VT_ENTER();
+
+    mutex = (struct rt_mutex *)rt_calloc(1, sizeof(struct rt_mutex));
+    ipc = (struct vt_ipc *)rt_calloc(1, sizeof(struct vt_ipc));
+    if (mutex == RT_NULL || ipc == RT_NULL)
+    {
+        rt_free(mutex);
+        rt_free(ipc);
+        return RT_NULL;
+    }
+
+    rt_list_init(&ipc->suspend);
+    ipc->flag = flag;
+    sim_name_copy(mutex->parent.name, name);
+    mutex->parent.type = RT_Object_Class_Mutex;
+    mutex->value = 1;
+    mutex->host = ipc;
+
+    return mutex;
+}
+
+rt_err_t rt_mutex_delete(rt_mutex_t mutex)
+{
+    struct vt_ipc *ipc = (struct vt_ipc *)mutex->host;
+
+    VT_ENTER();
+
+    while (!rt_list_isempty(&ipc->suspend))
+    {
+        rt_list_entry(ipc->suspend.next, struct vt_thread, tlist)->thread->error = -RT_ERROR;
+        vt_resume_first(&ipc->suspend);
+    }
+    rt_free(ipc);
+    rt_free(mutex);
+    vt_schedule();
+
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    struct vt_ipc *ipc = (struct vt_ipc *)mutex->host;
+    struct rt_thread *self;
+    rt_err_t result;
+
+    VT_ENTER();
+    self = vt_self->thread;
+
+    if (mutex->owner == self)
+    {
+        mutex->hold++;
+        return RT_EOK;
+    }
+
+    if (mutex->value > 0)
+    {
+        mutex->value = 0;
+        mutex->owner = self;
+        mutex->hold = 1;
+        return RT_EOK;
+    }
+
+    if (time == 0)
+        return -RT_ETIMEOUT;
+
+    /* The release makes the woken thread the owner */
+    result = vt_suspend(&ipc->suspend, ipc->flag, time);
+
+    return result;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    struct vt_ipc *ipc = (struct vt_ipc *)mutex->host;
+    struct vt_thread *vt;
+
+    VT_ENTER();
+
+    if (mutex->owner != vt_self->thread)
+        return -RT_ERROR;
+
+    if (--mutex->hold > 0)
+        return RT_EOK;
+
+    if (!rt_list_isempty(&ipc->suspend))
+    {
+        vt = rt_list_entry(ipc->suspend.next, struct vt_thread, tlist);
+        mutex->owner = vt->thread;
+        mutex->hold = 1;
+        vt_resume_first(&ipc->suspend);
+        vt_schedule();
+    }
+    else
+    {
+        mutex->owner = RT_NULL;
+        mutex->value = 1;
+    }
+
+    return RT_EOK;
+}
+
+/* Timer */
+
+rt_timer_t rt_timer_create(const char *name,
+                           void (*timeout)(void *parameter),
+                           void       *parameter,
+                           rt_tick_t   time,
+                           rt_uint8_t  flag)
+{
+    struct rt_timer *timer;
+
+    VT_ENTER();
+
+    timer = (struct rt_timer *)rt_calloc(1, sizeof(struct rt_timer));
+    if (timer == RT_NULL)
+        return RT_NULL;
+
+    sim_name_copy(timer->parent.name, name);
+    timer->parent.type = RT_Object_Class_Timer;
+    timer->parent.flag = flag & ~RT_TIMER_FLAG_ACTIVATED;
+    rt_list_init(&timer->row);
+    timer->timeout_func = timeout;
+    timer->parameter = parameter;
+    timer->init_tick = time;
+
+    return timer;
+}
+
+rt_err_t rt_timer_delete(rt_timer_t timer)
+{
+    VT_ENTER();
+
+    vt_timer_stop(timer);
+    rt_free(timer);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer)
+{
+    VT_ENTER();
+
+    vt_timer_start(timer);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer)
+{
+    VT_ENTER();
+
+    if (!(timer->parent.flag & RT_TIMER_FLAG_ACTIVATED))
+        return -RT_ERROR;
+
+    vt_timer_stop(timer);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg)
+{
+    VT_ENTER();
+
+    switch (cmd)
+    {
+    case RT_TIMER_CTRL_GET_TIME:
+        *(rt_tick_t *)arg = timer->init_tick;
+        break;
+    case RT_TIMER_CTRL_SET_TIME:
+        timer->init_tick = *(rt_tick_t *)arg;
+        break;
+    case RT_TIMER_CTRL_SET_ONESHOT:
+        timer->parent.flag &= ~RT_TIMER_FLAG_PERIODIC;
+        break;
+    case RT_TIMER_CTRL_SET_PERIODIC:
+        timer->parent.flag |= RT_TIMER_FLAG_PERIODIC;
+        break;
+    }
+
+    return RT_EOK;
+}
@@ -0,0 +1,554 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * The simulated board: the device framework, the pins and the mock I2C
+ * buses. It only uses the kernel API, so it runs on either kernel port.
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <rtdevice.h>
+#include <sim.h>
+
+/* Device framework */
+
+static rt_list_t sim_device_list = RT_LIST_OBJECT_INIT(sim_device_list);
+
+rt_device_t rt_device_find(const char *name)
+{
+    rt_device_t dev = RT_NULL;
+    rt_list_t *node;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_for_each(node, &sim_device_list)
+    {
+        rt_device_t d = rt_list_entry(node, struct rt_device, parent.list);
+
+        if (rt_strncmp(d->parent.name, name, RT_NAME_MAX) == 0)
+        {
+            dev = d;
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return dev;
+}
+
+rt_err_t rt_device_register(rt_device_t dev, const char *name, rt_uint16_t flags)
+{
+    rt_base_t level;
+
+    if (dev == RT_NULL)
+        return -RT_ERROR;
+
+    if (rt_device_find(name) != RT_NULL)
+        return -RT_ERROR;
+
+    sim_name_copy(dev->parent.name, name);
+    dev->parent.type = RT_Object_Class_Device;
+    dev->flag = flags;
+    dev->ref_count = 0;
+    dev->open_flag = 0;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_insert_before(&sim_device_list, &dev->parent.list);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_device_unregister(rt_device_t dev)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&dev->parent.list);
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_device_init(rt_device_t dev)
+{
+    rt_err_t result = RT_EOK;
+
+    RT_ASSERT(dev != RT_NULL);
+
+    if (dev->init != RT_NULL && !(dev->flag & RT_DEVICE_FLAG_ACTIVATED))
+    {
+        result = dev->init(dev);
+        if (result == RT_EOK)
+        {
+            dev->flag |= RT_DEVICE_FLAG_ACTIVATED;
+        }
+    }
+
+    return result;
+}
+
+rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    rt_err_t result = RT_EOK;
+
+    RT_ASSERT(dev != RT_NULL);
+
+    if (!(dev->flag & RT_DEVICE_FLAG_ACTIVATED))
+    {
+        if (dev->init != RT_NULL)
+        {
+            result = dev->init(dev);
+            if (result != RT_EOK)
+            {
+                return result;
+            }
+        }
+        dev->flag |= RT_DEVICE_FLAG_ACTIVATED;
+    }
+
+    /* device is a stand alone device and opened */
+    if ((dev->flag & RT_DEVICE_FLAG_STANDALONE) && (dev->open_flag & RT_DEVICE_OFLAG_OPEN))
+    {
+        return -RT_EBUSY;
+    }
+
+    if (dev->open != RT_NULL)
+    {
+        result = dev->open(dev, oflag);
+    }
+    else
+    {
+        dev->open_flag = (oflag & RT_DEVICE_OFLAG_MASK);
+    }
+
+    if (result == RT_EOK || result == -RT_ENOSYS)
+    {
+        dev->open_flag |= RT_DEVICE_OFLAG_OPEN;
+        dev->ref_count++;
+        RT_ASSERT(dev->ref_count != 0);
+    }
+
+    return result;
+}
+
+rt_err_t rt_device_close(rt_device_t dev)
+{
+    rt_err_t result = RT_EOK;
+
+    RT_ASSERT(dev != RT_NULL);
+
+    if (dev->ref_count == 0)
+        return -RT_ERROR;
+
+    dev->ref_count--;
+    if (dev->ref_count != 0)
+        return RT_EOK;
+
+    if (dev->close != RT_NULL)
+    {
+        result = dev->close(dev);
+    }
+
+    if (result == RT_EOK || result == -RT_ENOSYS)
+        dev->open_flag = RT_DEVICE_OFLAG_CLOSE;
+
+    return result;
+}
+
+rt_size_t rt_device_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    RT_ASSERT(dev != RT_NULL);
+
+    if (dev->ref_count == 0)
+        return 0;
+
+    if (dev->read != RT_NULL)
+        return dev->read(dev, pos, buffer, size);
+
+    return 0;
+}
+
+rt_size_t rt_device_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    RT_ASSERT(dev != RT_NULL);
+
+    if (dev->ref_count == 0)
+        return 0;
+
+    if (dev->write != RT_NULL)
+        return dev->write(dev, pos, buffer, size);
+
+    return 0;
+}
+
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg)
+{
+    RT_ASSERT(dev != RT_NULL);
+
+    if (dev->control != RT_NULL)
+        return dev->control(dev, cmd, arg);
+
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_device_set_rx_indicate(rt_device_t dev, rt_err_t (*rx_ind)(rt_device_t dev, rt_size_t size))
+{
+    RT_ASSERT(dev != RT_NULL);
+
+    dev->rx_indicate = rx_ind;
+
+    return RT_EOK;
+}
+
+/* Pins */
+
+struct sim_pin
+{
+    rt_uint8_t  mode;
+    rt_uint8_t  value;
+    rt_uint8_t  irq_mode;
+    rt_uint8_t  irq_enabled;
+    void (*hdr)(void *args);
+    void       *args;
+};
+
+static struct sim_pin sim_pins[SIM_PIN_MAX];
+
+void rt_pin_mode(rt_base_t pin, rt_base_t mode)
+{
+    if (pin < 0 || pin >= SIM_PIN_MAX)
+        return;
+
+    sim_pins[pin].mode = mode;
+    if (mode == PIN_MODE_INPUT_PULLUP)
+        sim_pins[pin].value = PIN_HIGH;
+    else if (mode == PIN_MODE_INPUT_PULLDOWN)
+        sim_pins[pin].value = PIN_LOW;
+}
+
+void rt_pin_write(rt_base_t pin, rt_base_t value)
+{
+    if (pin < 0 || pin >= SIM_PIN_MAX)
+        return;
+
+    sim_pins[pin].value = value ? PIN_HIGH : PIN_LOW;
+}
+
+int rt_pin_read(rt_base_t pin)
+{
+    if (pin < 0 || pin >= SIM_PIN_MAX)
+        return PIN_LOW;
+
+    return sim_pins[pin].value;
+}
+
+rt_err_t rt_pin_attach_irq(rt_int32_t pin, rt_uint32_t mode, void (*hdr)(void *args), void *args)
+{
+    rt_base_t level;
+
+    if (pin < 0 || pin >= SIM_PIN_MAX)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+    sim_pins[pin].irq_mode = mode;
+    sim_pins[pin].hdr = hdr;
+    sim_pins[pin].args = args;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_pin_detach_irq(rt_int32_t pin)
+{
+    rt_base_t level;
+
+    if (pin < 0 || pin >= SIM_PIN_MAX)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+    sim_pins[pin].hdr = RT_NULL;
+    sim_pins[pin].irq_enabled = 0;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+rt_err_t rt_pin_irq_enable(rt_base_t pin, rt_uint32_t enabled)
+{
+    if (pin < 0 || pin >= SIM_PIN_MAX)
+        return -RT_EINVAL;
+
+    sim_pins[pin].irq_enabled = enabled ? 1 : 0;
+
+    return RT_EOK;
+}
+
+/*
+ * Drive a pin, e.g. the nINT output of a chip model. The handler runs in
+ * interrupt context of the calling thread with interrupts disabled.
+ */
+void sim_pin_set(rt_base_t pin, rt_base_t value)
+{
+    struct sim_pin *p;
+    rt_base_t level;
+    rt_uint8_t old;
+    rt_bool_t fire = RT_FALSE;
+
+    if (pin < 0 || pin >= SIM_PIN_MAX)
+        return;
+
+    p = &sim_pins[pin];
+
+    level = rt_hw_interrupt_disable();
+    old = p->value;
+    p->value = value ? PIN_HIGH : PIN_LOW;
+
+    if (p->irq_enabled && p->hdr != RT_NULL)
+    {
+        switch (p->irq_mode)
+        {
+        case PIN_IRQ_MODE_RISING:
+            fire = (old == PIN_LOW && p->value == PIN_HIGH);
+            break;
+        case PIN_IRQ_MODE_FALLING:
+            fire = (old == PIN_HIGH && p->value == PIN_LOW);
+            break;
+        case PIN_IRQ_MODE_RISING_FALLING:
+            fire = (old != p->value);
+            break;
+        case PIN_IRQ_MODE_HIGH_LEVEL:
+            fire = (p->value == PIN_HIGH);
+            break;
+        case PIN_IRQ_MODE_LOW_LEVEL:
+            fire = (p->value == PIN_LOW);
+            break;
+        }
+    }
+
+    if (fire)
+    {
+        rt_interrupt_enter();
+        p->hdr(p->args);
+        rt_interrupt_leave();
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/* Mock I2C buses */
+
+struct sim_i2c_bus
+{
+    struct rt_i2c_bus_device parent;
+
+    rt_list_t                devs;      /* The chips on the bus */
+    rt_uint32_t              hz;        /* SCL frequency */
+};
+
+/* Start, 9 clocks per byte including the address, stop */
+static rt_uint32_t sim_i2c_time_us(struct sim_i2c_bus *bus, rt_uint16_t len)
+{
+    return (rt_uint32_t)(((rt_uint64_t)(len + 1) * 9 + 2) * 1000000 / bus->hz);
+}
+
+static struct sim_i2c_dev *sim_i2c_find(struct sim_i2c_bus *bus, rt_uint16_t addr)
+{
+    rt_list_t *node;
+
+    rt_list_for_each(node, &bus->devs)
+    {
+        struct sim_i2c_dev *dev = rt_list_entry(node, struct sim_i2c_dev, list);
+
+        if (dev->addr == addr)
+        {
+            return dev;
+        }
+    }
+
+    return RT_NULL;
+}
+
+static rt_size_t sim_i2c_xfer(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num)
+{
+    struct sim_i2c_bus *sbus = (struct sim_i2c_bus *)bus;
+    struct sim_i2c_dev *dev;
+    rt_uint32_t i;
+    rt_err_t res;
+
+    for (i = 0; i < num; i++)
+    {
+        sim_delay_us(sim_i2c_time_us(sbus, msgs[i].len));
+
+        dev = sim_i2c_find(sbus, msgs[i].addr);
+        if (dev == RT_NULL)
+        {
+            /* Nobody acknowledged the address */
+            return (rt_size_t)-RT_EIO;
+        }
+
+        if (msgs[i].flags & RT_I2C_RD)
+            res = dev->read(dev, msgs[i].buf, msgs[i].len);
+        else
+            res = dev->write(dev, msgs[i].buf, msgs[i].len);
+
+        if (res != RT_EOK && !(msgs[i].flags & RT_I2C_IGNORE_NACK))
+        {
+            return (rt_size_t)-RT_EIO;
+        }
+    }
+
+    return num;
+}
+
+static const struct rt_i2c_bus_device_ops sim_i2c_ops =
+{
+    sim_i2c_xfer,
+    RT_NULL,
+    RT_NULL
+};
+
+rt_err_t rt_i2c_bus_device_register(struct rt_i2c_bus_device *bus, const char *bus_name)
+{
+    bus->lock = rt_mutex_create(bus_name, RT_IPC_FLAG_FIFO);
+    if (bus->lock == RT_NULL)
+        return -RT_ENOMEM;
+
+    if (bus->timeout == 0)
+        bus->timeout = RT_TICK_PER_SECOND;
+
+    bus->parent.type = RT_Device_Class_I2CBUS;
+    bus->parent.user_data = bus;
+
+    return rt_device_register(&bus->parent, bus_name, RT_DEVICE_FLAG_RDWR);
+}
+
+struct rt_i2c_bus_device *rt_i2c_bus_device_find(const char *bus_name)
+{
+    rt_device_t dev = rt_device_find(bus_name);
+
+    if (dev == RT_NULL || dev->type != RT_Device_Class_I2CBUS)
+        return RT_NULL;
+
+    return (struct rt_i2c_bus_device *)dev->user_data;
+}
+
+rt_size_t rt_i2c_transfer(struct rt_i2c_bus_device *bus, struct rt_i2c_msg msgs[], rt_uint32_t num)
+{
+    rt_size_t ret;
+
+    if (bus->ops->master_xfer == RT_NULL)
+        return 0;
+
+    rt_mutex_take(bus->lock, RT_WAITING_FOREVER);
+    ret = bus->ops->master_xfer(bus, msgs, num);
+    rt_mutex_release(bus->lock);
+
+    return ret;
+}
+
+rt_size_t rt_i2c_master_send(struct rt_i2c_bus_device *bus, rt_uint16_t addr, rt_uint16_t flags,
+                             const rt_uint8_t *buf, rt_uint32_t count)
+{
+    rt_err_t ret;
+    struct rt_i2c_msg msg;
+
+    msg.addr  = addr;
+    msg.flags = flags;
+    msg.len   = count;
+    msg.buf   = (rt_uint8_t *)buf;
+
+    ret = rt_i2c_transfer(bus, &msg, 1);
+
+    return (ret > 0) ? count : ret;
+}
+
+rt_size_t rt_i2c_master_recv(struct rt_i2c_bus_device *bus, rt_uint16_t addr, rt_uint16_t flags,
+                             rt_uint8_t *buf, rt_uint32_t count)
+{
+    rt_err_t ret;
+    struct rt_i2c_msg msg;
+
+    RT_ASSERT(bus != RT_NULL);
+
+    msg.addr   = addr;
+    msg.flags  = flags | RT_I2C_RD;
+    msg.len    = count;
+    msg.buf    = buf;
+
+    ret = rt_i2c_transfer(bus, &msg, 1);
+
+    return (ret > 0) ? count : ret;
+}
+
+struct rt_i2c_bus_device *sim_i2c_bus_create(const char *name, rt_uint32_t hz)
+{
+    struct sim_i2c_bus *bus;
+
+    bus = (struct sim_i2c_bus *)rt_calloc(1, sizeof(struct sim_i2c_bus));
+    if (bus == RT_NULL)
+        return RT_NULL;
+
+    rt_list_init(&bus->devs);
+    bus->hz = hz ? hz : 100000;
+    bus->parent.ops = &sim_i2c_ops;
+
+    if (rt_i2c_bus_device_register(&bus->parent, name) != RT_EOK)
+    {
+        rt_free(bus);
+        return RT_NULL;
+    }
+
+    return &bus->parent;
+}
+
+rt_err_t sim_i2c_attach(struct rt_i2c_bus_device *bus, struct sim_i2c_dev *dev)
+{
+    struct sim_i2c_bus *sbus = (struct sim_i2c_bus *)bus;
+
+    if (sim_i2c_find(sbus, dev->addr) != RT_NULL)
+        return -RT_EBUSY;
+
+    rt_mutex_take(bus->lock, RT_WAITING_FOREVER);
+    rt_list_insert_before(&sbus->devs, &dev->list);
+    rt_mutex_release(bus->lock);
+
+    return RT_EOK;
+}
+
+void sim_i2c_detach(struct sim_i2c_dev *dev)
+{
+    rt_list_remove(&dev->list);
+}
+
+/* Environment */
+
+static struct sim_env sim_env_now =
+{
+    25.0, 50.0, 300.0, 400, 0
+};
+
+void sim_env_set(const struct sim_env *env)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    sim_env_now = *env;
+    rt_hw_interrupt_enable(level);
+}
+
+void sim_env_get(struct sim_env *env)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *env = sim_env_now;
+    rt_hw_interrupt_enable(level);
+}
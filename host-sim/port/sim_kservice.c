@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+/*
+ * Kernel services that do not depend on the scheduler: console, heap, object names,
+ * assertion and the automatic initialization of INIT_xxx_EXPORT.
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <sim.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+    rt_base_t level;
+
+    va_start(args, fmt);
+    level = rt_hw_interrupt_disable();
+    vprintf(fmt, args);
+    fflush(stdout);
+    rt_hw_interrupt_enable(level);
+    va_end(args);
+}
+
+void sim_name_copy(char name[RT_NAME_MAX + 1], const char *src)
+{
+    rt_strncpy(name, src, RT_NAME_MAX);
+    name[RT_NAME_MAX] = '\0';
+}
+
+rt_int32_t rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args)
+{
+    return vsnprintf(buf, size, fmt, args);
+}
+
+rt_int32_t rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...)
+{
+    rt_int32_t n;
+    va_list args;
+
+    va_start(args, fmt);
+    n = vsnprintf(buf, size, fmt, args);
+    va_end(args);
+
+    return n;
+}
+
+rt_int32_t rt_sprintf(char *buf, const char *fmt, ...)
+{
+    rt_int32_t n;
+    va_list args;
+
+    va_start(args, fmt);
+    n = vsprintf(buf, fmt, args);
+    va_end(args);
+
+    return n;
+}
+
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line)
+{
+    fprintf(stderr, "(%s) assertion failed at function:%s, line number:%lu\n", ex, func, (unsigned long)line);
+    abort();
+}
+
+void *rt_malloc(rt_size_t size)
+{
+    return malloc(size);
+}
+
+void *rt_realloc(void *ptr, rt_size_t newsize)
+{
+    return realloc(ptr, newsize);
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    return calloc(count, size);
+}
+
+void rt_free(void *ptr)
+{
+    free(ptr);
+}
+
+/* the linker provides the bounds of the "rti_fn" section */
+extern const struct rt_init_desc __start_rti_fn[] __attribute__((weak));
+extern const struct rt_init_desc __stop_rti_fn[] __attribute__((weak));
+
+/*
+ * Run the INIT_xxx_EXPORT functions level by level, as rt_components_init()
+ * does on the target. Call it once from main() before using the framework.
+ */
+int rt_components_init(void)
+{
+    const struct rt_init_desc *desc;
+    char level;
+
+    if (__start_rti_fn == RT_NULL)
+    {
+        return 0;
+    }
+
+    for (level = '1'; level <= '6'; level++)
+    {
+        for (desc = __start_rti_fn; desc < __stop_rti_fn; desc++)
+        {
+            if (desc->level[0] == level)
+            {
+                desc->fn();
+            }
+        }
+    }
+
+    return 0;
+}
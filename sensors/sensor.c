@@ -1,443 +1,2377 @@
-/*
- * Copyright (c) 2006-2018, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2019-01-31     flybreak     first version
- */
-
-#include "sensor.h"
-
-#define DBG_TAG  "sensor"
-#define DBG_LVL DBG_INFO
-#include <rtdbg.h>
-
-#include <string.h>
-
-static char *const sensor_name_str[] =
-{
-    "none",
-    "acce_",     /* Accelerometer     */
-    "gyro_",     /* Gyroscope         */
-    "mag_",      /* Magnetometer      */
-    "temp_",     /* Temperature       */
-    "humi_",     /* Relative Humidity */
-    "baro_",     /* Barometer         */
-    "li_",       /* Ambient light     */
-    "pr_",       /* Proximity         */
-    "hr_",       /* Heart Rate        */
-    "tvoc_",     /* TVOC Level        */
-    "noi_",      /* Noise Loudness    */
-    "step_",     /* Step sensor       */
-    "forc_"      /* Force sensor      */
-    //add
-    "eco2_",     /* CO2 Level        */
-};
-
-/* Sensor interrupt correlation function */
-/*
- * Sensor interrupt handler function
- */
-void rt_sensor_cb(rt_sensor_t sen)
-{
-    if (sen->parent.rx_indicate == RT_NULL)
-    {
-        return;
-    }
-
-    if (sen->irq_handle != RT_NULL)
-    {
-        sen->irq_handle(sen);
-    }
-
-    /* The buffer is not empty. Read the data in the buffer first */
-    if (sen->data_len > 0)
-    {
-        sen->parent.rx_indicate(&sen->parent, sen->data_len / sizeof(struct rt_sensor_data));
-    }
-    else if (sen->config.mode == RT_SENSOR_MODE_INT)
-    {
-        /* The interrupt mode only produces one data at a time */
-        sen->parent.rx_indicate(&sen->parent, 1);
-    }
-    else if (sen->config.mode == RT_SENSOR_MODE_FIFO)
-    {
-        sen->parent.rx_indicate(&sen->parent, sen->info.fifo_max);
-    }
-}
-
-/* ISR for sensor interrupt */
-static void irq_callback(void *args)
-{
-    rt_sensor_t sensor = (rt_sensor_t)args;
-    rt_uint8_t i;
-
-    if (sensor->module)
-    {
-        /* Invoke a callback for all sensors in the module */
-        for (i = 0; i < sensor->module->sen_num; i++)
-        {
-            rt_sensor_cb(sensor->module->sen[i]);
-        }
-    }
-    else
-    {
-        rt_sensor_cb(sensor);
-    }
-}
-
-/* Sensor interrupt initialization function */
-static rt_err_t rt_sensor_irq_init(rt_sensor_t sensor)
-{
-    if (sensor->config.irq_pin.pin == RT_PIN_NONE)
-    {
-        return -RT_EINVAL;
-    }
-
-    rt_pin_mode(sensor->config.irq_pin.pin, sensor->config.irq_pin.mode);
-
-    if (sensor->config.irq_pin.mode == PIN_MODE_INPUT_PULLDOWN)
-    {
-        rt_pin_attach_irq(sensor->config.irq_pin.pin, PIN_IRQ_MODE_RISING, irq_callback, (void *)sensor);
-    }
-    else if (sensor->config.irq_pin.mode == PIN_MODE_INPUT_PULLUP)
-    {
-        rt_pin_attach_irq(sensor->config.irq_pin.pin, PIN_IRQ_MODE_FALLING, irq_callback, (void *)sensor);
-    }
-    else if (sensor->config.irq_pin.mode == PIN_MODE_INPUT)
-    {
-        rt_pin_attach_irq(sensor->config.irq_pin.pin, PIN_IRQ_MODE_RISING_FALLING, irq_callback, (void *)sensor);
-    }
-
-    rt_pin_irq_enable(sensor->config.irq_pin.pin, RT_TRUE);
-
-    LOG_I("interrupt init success");
-
-    return 0;
-}
-
-/* RT-Thread Device Interface */
-static rt_err_t rt_sensor_open(rt_device_t dev, rt_uint16_t oflag)
-{
-    rt_sensor_t sensor = (rt_sensor_t)dev;
-    RT_ASSERT(dev != RT_NULL);
-    rt_err_t res = RT_EOK;
-
-    if (sensor->module)
-    {
-        /* take the module mutex */
-        rt_mutex_take(sensor->module->lock, RT_WAITING_FOREVER);
-    }
-
-    if (sensor->module != RT_NULL && sensor->info.fifo_max > 0 && sensor->data_buf == RT_NULL)
-    {
-        /* Allocate memory for the sensor buffer */
-        sensor->data_buf = rt_malloc(sizeof(struct rt_sensor_data) * sensor->info.fifo_max);
-        if (sensor->data_buf == RT_NULL)
-        {
-            res = -RT_ENOMEM;
-            goto __exit;
-        }
-    }
-
-    if (oflag & RT_DEVICE_FLAG_RDONLY && dev->flag & RT_DEVICE_FLAG_RDONLY)
-    {
-        if (sensor->ops->control != RT_NULL)
-        {
-            /* If polling mode is supported, configure it to polling mode */
-            sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_MODE, (void *)RT_SENSOR_MODE_POLLING);
-        }
-        sensor->config.mode = RT_SENSOR_MODE_POLLING;
-    }
-    else if (oflag & RT_DEVICE_FLAG_INT_RX && dev->flag & RT_DEVICE_FLAG_INT_RX)
-    {
-        if (sensor->ops->control != RT_NULL)
-        {
-            /* If interrupt mode is supported, configure it to interrupt mode */
-            sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_MODE, (void *)RT_SENSOR_MODE_INT);
-        }
-        /* Initialization sensor interrupt */
-        rt_sensor_irq_init(sensor);
-        sensor->config.mode = RT_SENSOR_MODE_INT;
-    }
-    else if (oflag & RT_DEVICE_FLAG_FIFO_RX && dev->flag & RT_DEVICE_FLAG_FIFO_RX)
-    {
-        if (sensor->ops->control != RT_NULL)
-        {
-            /* If fifo mode is supported, configure it to fifo mode */
-            sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_MODE, (void *)RT_SENSOR_MODE_FIFO);
-        }
-        /* Initialization sensor interrupt */
-        rt_sensor_irq_init(sensor);
-        sensor->config.mode = RT_SENSOR_MODE_FIFO;
-    }
-    else
-    {
-        res = -RT_EINVAL;
-        goto __exit;
-    }
-
-    /* Configure power mode to normal mode */
-    if (sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, (void *)RT_SENSOR_POWER_NORMAL) == RT_EOK)
-    {
-        sensor->config.power = RT_SENSOR_POWER_NORMAL;
-    }
-
-__exit:
-    if (sensor->module)
-    {
-        /* release the module mutex */
-        rt_mutex_release(sensor->module->lock);
-    }
-
-    return res;
-}
-
-static rt_err_t rt_sensor_close(rt_device_t dev)
-{
-    rt_sensor_t sensor = (rt_sensor_t)dev;
-    int i;
-
-    RT_ASSERT(dev != RT_NULL);
-
-    if (sensor->module)
-    {
-        rt_mutex_take(sensor->module->lock, RT_WAITING_FOREVER);
-    }
-
-    /* Configure power mode to power down mode */
-    if (sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, (void *)RT_SENSOR_POWER_DOWN) == RT_EOK)
-    {
-        sensor->config.power = RT_SENSOR_POWER_DOWN;
-    }
-
-    /* Sensor disable interrupt */
-    if (sensor->config.irq_pin.pin != RT_PIN_NONE)
-    {
-        rt_pin_irq_enable(sensor->config.irq_pin.pin, RT_FALSE);
-    }
-
-    if (sensor->module != RT_NULL && sensor->info.fifo_max > 0 && sensor->data_buf != RT_NULL)
-    {
-        for (i = 0; i < sensor->module->sen_num; i ++)
-        {
-            if (sensor->module->sen[i]->parent.ref_count > 0)
-                goto __exit;
-        }
-
-        /* Free memory for the sensor buffer */
-        for (i = 0; i < sensor->module->sen_num; i ++)
-        {
-            if (sensor->module->sen[i]->data_buf != RT_NULL)
-            {
-                rt_free(sensor->module->sen[i]->data_buf);
-                sensor->module->sen[i]->data_buf = RT_NULL;
-            }
-        }
-    }
-
-__exit:
-    if (sensor->module)
-    {
-        rt_mutex_release(sensor->module->lock);
-    }
-
-    return RT_EOK;
-}
-
-static rt_size_t rt_sensor_read(rt_device_t dev, rt_off_t pos, void *buf, rt_size_t len)
-{
-    rt_sensor_t sensor = (rt_sensor_t)dev;
-    rt_size_t result = 0;
-    RT_ASSERT(dev != RT_NULL);
-
-    if (buf == NULL || len == 0)
-    {
-        return 0;
-    }
-
-    if (sensor->module)
-    {
-        rt_mutex_take(sensor->module->lock, RT_WAITING_FOREVER);
-    }
-
-    /* The buffer is not empty. Read the data in the buffer first */
-    if (sensor->data_len > 0)
-    {
-        if (len > sensor->data_len / sizeof(struct rt_sensor_data))
-        {
-            len = sensor->data_len / sizeof(struct rt_sensor_data);
-        }
-
-        rt_memcpy(buf, sensor->data_buf, len * sizeof(struct rt_sensor_data));
-
-        /* Clear the buffer */
-        sensor->data_len = 0;
-        result = len;
-    }
-    else
-    {
-        /* If the buffer is empty read the data */
-        result = sensor->ops->fetch_data(sensor, buf, len);
-    }
-
-    if (sensor->module)
-    {
-        rt_mutex_release(sensor->module->lock);
-    }
-
-    return result;
-}
-
-static rt_err_t rt_sensor_control(rt_device_t dev, int cmd, void *args)
-{
-    rt_sensor_t sensor = (rt_sensor_t)dev;
-    rt_err_t result = RT_EOK;
-    RT_ASSERT(dev != RT_NULL);
-
-    if (sensor->module)
-    {
-        rt_mutex_take(sensor->module->lock, RT_WAITING_FOREVER);
-    }
-
-    switch (cmd)
-    {
-    case RT_SENSOR_CTRL_GET_ID:
-        if (args)
-        {
-            sensor->ops->control(sensor, RT_SENSOR_CTRL_GET_ID, args);
-        }
-        break;
-    case RT_SENSOR_CTRL_GET_INFO:
-        if (args)
-        {
-            rt_memcpy(args, &sensor->info, sizeof(struct rt_sensor_info));
-        }
-        break;
-    case RT_SENSOR_CTRL_SET_RANGE:
-
-        /* Configuration measurement range */
-        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_RANGE, args);
-        if (result == RT_EOK)
-        {
-            sensor->config.range = (rt_int32_t)args;
-            LOG_D("set range %d", sensor->config.range);
-        }
-        break;
-    case RT_SENSOR_CTRL_SET_ODR:
-
-        /* Configuration data output rate */
-        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_ODR, args);
-        if (result == RT_EOK)
-        {
-            sensor->config.odr = (rt_uint32_t)args & 0xFFFF;
-            LOG_D("set odr %d", sensor->config.odr);
-        }
-        break;
-    case RT_SENSOR_CTRL_SET_POWER:
-
-        /* Configuration sensor power mode */
-        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, args);
-        if (result == RT_EOK)
-        {
-            sensor->config.power = (rt_uint32_t)args & 0xFF;
-            LOG_D("set power mode code:", sensor->config.power);
-        }
-        break;
-    case RT_SENSOR_CTRL_SELF_TEST:
-
-        /* Device self-test */
-        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SELF_TEST, args);
-        break;
-    default:
-        return -RT_ERROR;
-    }
-
-    if (sensor->module)
-    {
-        rt_mutex_release(sensor->module->lock);
-    }
-
-    return result;
-}
-
-#ifdef RT_USING_DEVICE_OPS
-const static struct rt_device_ops rt_sensor_ops =
-{
-    RT_NULL,
-    rt_sensor_open,
-    rt_sensor_close,
-    rt_sensor_read,
-    RT_NULL,
-    rt_sensor_control
-};
-#endif
-
-/*
- * sensor register
- */
-//int rt_hw_aht10_init(const char* name, struct rt_sensor_config* cfg)
-
-int rt_hw_sensor_register(rt_sensor_t sensor,
-                          const char              *name,
-                          rt_uint32_t              flag,
-                          void                    *data)
-{
-    rt_int8_t result;
-    rt_device_t device;
-    RT_ASSERT(sensor != RT_NULL);
-
-    char *sensor_name = RT_NULL, *device_name = RT_NULL;
-
-    /* Add a type name for the sensor device */
-    sensor_name = sensor_name_str[sensor->info.type];
-    device_name = (char *)rt_calloc(1, rt_strlen(sensor_name) + 1 + rt_strlen(name));
-    if (device_name == RT_NULL)
-    {
-        LOG_E("device_name calloc failed!");
-        return -RT_ERROR;
-    }
-
-    rt_memcpy(device_name, sensor_name, rt_strlen(sensor_name) + 1);
-    strcat(device_name, name);
-
-    if (sensor->module != RT_NULL && sensor->module->lock == RT_NULL)
-    {
-        /* Create a mutex lock for the module */
-        sensor->module->lock = rt_mutex_create(name, RT_IPC_FLAG_FIFO);
-        if (sensor->module->lock == RT_NULL)
-        {
-            rt_free(device_name);
-            return -RT_ERROR;
-        }
-    }
-
-    device = &sensor->parent;
-
-#ifdef RT_USING_DEVICE_OPS
-    device->ops         = &rt_sensor_ops;
-#else
-    device->init        = RT_NULL;
-    device->open        = rt_sensor_open;
-    device->close       = rt_sensor_close;
-    device->read        = rt_sensor_read;
-    device->write       = RT_NULL;
-    device->control     = rt_sensor_control;
-#endif
-    device->type        = RT_Device_Class_Sensor;
-    device->rx_indicate = RT_NULL;
-    device->tx_complete = RT_NULL;
-    device->user_data   = data;
-
-    result = rt_device_register(device, device_name, flag | RT_DEVICE_FLAG_STANDALONE);
-    if (result != RT_EOK)
-    {
-        LOG_E("rt_sensor register err code: %d", result);
-        return result;
-    }
-
-    LOG_I("rt_sensor init success");
-    return RT_EOK;
-}
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-01-31     flybreak     first version
+ */
+
+#include "sensor.h"
+#include <rthw.h>
+
+#define DBG_TAG  "sensor"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#include <string.h>
+
+#ifndef RT_SENSOR_SCHED_THREAD_STACK_SIZE
+#define RT_SENSOR_SCHED_THREAD_STACK_SIZE  1024
+#endif
+#ifndef RT_SENSOR_SCHED_THREAD_PRIORITY
+#define RT_SENSOR_SCHED_THREAD_PRIORITY    10
+#endif
+
+#ifndef RT_SENSOR_IRQ_THREAD_STACK_SIZE
+#define RT_SENSOR_IRQ_THREAD_STACK_SIZE    1024
+#endif
+#ifndef RT_SENSOR_IRQ_THREAD_PRIORITY
+#define RT_SENSOR_IRQ_THREAD_PRIORITY      4
+#endif
+
+#define SENSOR_SCHED_WHEEL_SIZE            16     /* Number of slots in the timer wheel */
+#define SENSOR_SCHED_SLOT_MS               10     /* Time covered by one slot, unit: ms */
+#define SENSOR_SCHED_PERIOD_DEFAULT        1000   /* Period if neither odr nor period_min is set, unit: ms */
+#define SENSOR_SCHED_FIFO_DEPTH            8      /* Ring depth for scheduled sensors without fifo_max */
+#define SENSOR_PM_CHECK_MS                 500    /* Idle check interval when nothing is scheduled, unit: ms */
+
+static char *const sensor_name_str[] =
+{
+    "none",
+    "acce_",     /* Accelerometer     */
+    "gyro_",     /* Gyroscope         */
+    "mag_",      /* Magnetometer      */
+    "temp_",     /* Temperature       */
+    "humi_",     /* Relative Humidity */
+    "baro_",     /* Barometer         */
+    "li_",       /* Ambient light     */
+    "pr_",       /* Proximity         */
+    "hr_",       /* Heart Rate        */
+    "tvoc_",     /* TVOC Level        */
+    "noi_",      /* Noise Loudness    */
+    "step_",     /* Step sensor       */
+    "forc_",     /* Force sensor      */
+    //add
+    "eco2_",     /* CO2 Level        */
+};
+
+/* Registered sensors of each type, in registration order */
+static rt_list_t sensor_class_list[RT_SENSOR_CLASS_MAX];
+static rt_uint16_t sensor_class_num[RT_SENSOR_CLASS_MAX];
+static rt_bool_t sensor_class_inited = RT_FALSE;
+
+/*
+ * The fifo indexes and the last sample sequence are shared between an ISR
+ * producer and thread readers without a lock. Keep the compiler from moving
+ * the sample copy across the index or sequence update.
+ */
+#if defined(__GNUC__)
+#define SENSOR_BARRIER()    __asm__ volatile ("" : : : "memory")
+#else
+#define SENSOR_BARRIER()
+#endif
+
+/* Sensor clock correlation function */
+
+/*
+ * The sample clock extends a free running 32-bit counter to a 64-bit count
+ * of microseconds. By default it runs on the OS tick, so timestamps and
+ * fetch times only have tick resolution (1 ms at 1000 Hz) and short fetches
+ * read as 0 us. A BSP with a faster counter (e.g. the CP0 count register)
+ * registers it with rt_sensor_clock_register(). A timer reads the counter
+ * every half wrap period, so no wrap is missed while no sensor is read.
+ */
+static rt_uint32_t (*sensor_clock_read)(void) = rt_tick_get;
+static rt_uint32_t sensor_clock_freq = RT_TICK_PER_SECOND;
+static rt_uint32_t sensor_clock_last;
+static rt_uint32_t sensor_clock_rem;    /* counts not yet converted to us */
+static rt_uint64_t sensor_clock_us;
+static rt_timer_t  sensor_clock_timer = RT_NULL;
+
+static void sensor_clock_timeout(void *parameter)
+{
+    rt_sensor_get_ts_us();
+}
+
+/* (Re)arm the wrap guard for a counter running at freq Hz */
+static rt_err_t sensor_clock_guard(rt_uint32_t freq)
+{
+    rt_uint64_t period = ((rt_uint64_t)RT_TICK_PER_SECOND << 31) / freq;
+    rt_tick_t tick;
+
+    if (period >= RT_TICK_MAX / 2)
+    {
+        period = RT_TICK_MAX / 2 - 1;
+    }
+    tick = period > 0 ? (rt_tick_t)period : 1;
+
+    if (sensor_clock_timer == RT_NULL)
+    {
+        sensor_clock_timer = rt_timer_create("sen_clk", sensor_clock_timeout, RT_NULL, tick, RT_TIMER_FLAG_PERIODIC);
+        if (sensor_clock_timer == RT_NULL)
+        {
+            return -RT_ENOMEM;
+        }
+    }
+    else
+    {
+        rt_timer_stop(sensor_clock_timer);
+        rt_timer_control(sensor_clock_timer, RT_TIMER_CTRL_SET_TIME, &tick);
+    }
+
+    return rt_timer_start(sensor_clock_timer);
+}
+
+static int rt_sensor_clock_init(void)
+{
+    return sensor_clock_guard(sensor_clock_freq);
+}
+INIT_PREV_EXPORT(rt_sensor_clock_init);
+
+/*
+ * Register a free running 32-bit counter running at freq Hz as the sample clock
+ */
+rt_err_t rt_sensor_clock_register(rt_uint32_t (*read)(void), rt_uint32_t freq)
+{
+    rt_base_t level;
+
+    if (read == RT_NULL || freq == 0)
+    {
+        return -RT_EINVAL;
+    }
+
+    if (sensor_clock_guard(freq) != RT_EOK)
+    {
+        return -RT_ENOMEM;
+    }
+
+    level = rt_hw_interrupt_disable();
+    /* Fold the old counter in so time stays monotonic across the switch */
+    sensor_clock_us += ((rt_uint64_t)sensor_clock_rem +
+                        (rt_uint32_t)(sensor_clock_read() - sensor_clock_last)) * 1000000 / sensor_clock_freq;
+    sensor_clock_read = read;
+    sensor_clock_freq = freq;
+    sensor_clock_last = read();
+    sensor_clock_rem = 0;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/*
+ * Monotonic sample time in microseconds, it can be called from an ISR
+ */
+rt_uint64_t rt_sensor_get_ts_us(void)
+{
+    rt_base_t level;
+    rt_uint32_t now;
+    rt_uint64_t counts, us;
+
+    level = rt_hw_interrupt_disable();
+    now = sensor_clock_read();
+    counts = (rt_uint64_t)sensor_clock_rem + (rt_uint32_t)(now - sensor_clock_last);
+    sensor_clock_last = now;
+    sensor_clock_us += counts / sensor_clock_freq * 1000000;
+    sensor_clock_rem = counts % sensor_clock_freq;
+    us = sensor_clock_us + (rt_uint64_t)sensor_clock_rem * 1000000 / sensor_clock_freq;
+    rt_hw_interrupt_enable(level);
+
+    return us;
+}
+
+/*
+ * Resolution of rt_sensor_get_ts_us(), unit: us
+ */
+rt_uint32_t rt_sensor_get_ts_res_us(void)
+{
+    return (1000000 + sensor_clock_freq - 1) / sensor_clock_freq;
+}
+
+/*
+ * Fill in the timestamp of the records the driver did not stamp itself
+ * with 'now', or with the current time if 'now' is 0
+ */
+static void sensor_data_stamp_at(struct rt_sensor_data *data, rt_size_t num, rt_uint64_t now)
+{
+    rt_size_t i;
+
+    for (i = 0; i < num; i++)
+    {
+        if (data[i].timestamp_us == 0)
+        {
+            if (now == 0)
+            {
+                now = rt_sensor_get_ts_us();
+            }
+            data[i].timestamp_us = now;
+        }
+    }
+}
+
+static void sensor_data_stamp(struct rt_sensor_data *data, rt_size_t num)
+{
+    sensor_data_stamp_at(data, num, 0);
+}
+
+/*
+ * Time of the data-ready interrupt the next fetch answers, 0 if there was
+ * none. The sample is stamped when the sensor signalled it, not when the
+ * worker got round to reading it.
+ */
+static rt_uint64_t sensor_irq_ts_take(rt_sensor_t sensor)
+{
+    rt_base_t level;
+    rt_uint64_t ts;
+
+    if (sensor->config.mode != RT_SENSOR_MODE_INT)
+    {
+        return 0;
+    }
+
+    level = rt_hw_interrupt_disable();
+    ts = sensor->irq_ts_us;
+    sensor->irq_ts_us = 0;
+    rt_hw_interrupt_enable(level);
+
+    return ts;
+}
+
+/* Sensor registry correlation function */
+
+static void sensor_registry_add(rt_sensor_t sensor)
+{
+    rt_base_t level;
+    int i;
+
+    level = rt_hw_interrupt_disable();
+    if (!sensor_class_inited)
+    {
+        for (i = 0; i < RT_SENSOR_CLASS_MAX; i++)
+        {
+            rt_list_init(&sensor_class_list[i]);
+        }
+        sensor_class_inited = RT_TRUE;
+    }
+    rt_list_insert_before(&sensor_class_list[sensor->info.type], &sensor->class_node);
+    sensor_class_num[sensor->info.type]++;
+    rt_hw_interrupt_enable(level);
+}
+
+/*
+ * The first registered sensor of the type, RT_NULL if there is none
+ */
+rt_sensor_t rt_sensor_first(rt_uint8_t type)
+{
+    if (type >= RT_SENSOR_CLASS_MAX || !sensor_class_inited ||
+        rt_list_isempty(&sensor_class_list[type]))
+    {
+        return RT_NULL;
+    }
+
+    return rt_list_entry(sensor_class_list[type].next, struct rt_sensor_device, class_node);
+}
+
+/*
+ * The sensor registered after this one with the same type, RT_NULL at the end
+ */
+rt_sensor_t rt_sensor_next(rt_sensor_t sensor)
+{
+    RT_ASSERT(sensor != RT_NULL);
+
+    if (sensor->class_node.next == &sensor_class_list[sensor->info.type])
+    {
+        return RT_NULL;
+    }
+
+    return rt_list_entry(sensor->class_node.next, struct rt_sensor_device, class_node);
+}
+
+/*
+ * Find the first sensor of the type made by vendor with the model name.
+ * RT_SENSOR_VENDOR_UNKNOWN and a RT_NULL model match any sensor.
+ */
+rt_sensor_t rt_sensor_find(rt_uint8_t type, rt_uint8_t vendor, const char *model)
+{
+    rt_sensor_t sensor;
+
+    rt_sensor_foreach(sensor, type)
+    {
+        if (vendor != RT_SENSOR_VENDOR_UNKNOWN && sensor->info.vendor != vendor)
+        {
+            continue;
+        }
+        if (model != RT_NULL && (sensor->info.model == RT_NULL || strcmp(sensor->info.model, model)))
+        {
+            continue;
+        }
+        return sensor;
+    }
+
+    return RT_NULL;
+}
+
+/*
+ * Number of registered sensors of the type
+ */
+rt_size_t rt_sensor_count(rt_uint8_t type)
+{
+    if (type >= RT_SENSOR_CLASS_MAX)
+    {
+        return 0;
+    }
+
+    return sensor_class_num[type];
+}
+
+/* Sensor sample record correlation function */
+
+/*
+ * Start a stream of compact records at base_us, usually the timestamp of
+ * the first sample or 0
+ */
+void rt_sensor_sample_stream_init(struct rt_sensor_sample_stream *stream, rt_uint64_t base_us)
+{
+    RT_ASSERT(stream != RT_NULL);
+
+    stream->base_us = base_us;
+}
+
+/*
+ * Convert a sample to a compact record of the stream. The delta is rounded
+ * to whole milliseconds and the stream advances by the rounded value, so
+ * the rounding error does not add up over the stream.
+ */
+rt_err_t rt_sensor_sample_pack(struct rt_sensor_sample_stream *stream, const struct rt_sensor_data *data,
+                               struct rt_sensor_sample *sample)
+{
+    rt_uint64_t delta = 0;
+    rt_int32_t value;
+
+    RT_ASSERT(stream != RT_NULL);
+    RT_ASSERT(data != RT_NULL);
+    RT_ASSERT(sample != RT_NULL);
+
+    switch (data->type)
+    {
+    case RT_SENSOR_CLASS_NONE:
+    case RT_SENSOR_CLASS_ACCE:
+    case RT_SENSOR_CLASS_GYRO:
+    case RT_SENSOR_CLASS_MAG:
+        return -RT_EINVAL;
+    default:
+        /* Every scalar member of the data union is a 32-bit integer */
+        value = data->data.temp;
+        break;
+    }
+
+    sample->channel = data->type;
+    sample->flags = (data->flags & RT_SENSOR_DATA_FLAG_EVENT) ? RT_SENSOR_SAMPLE_FLAG_EVENT : 0;
+
+    if (data->timestamp_us > stream->base_us)
+    {
+        delta = (data->timestamp_us - stream->base_us + 500) / 1000;
+    }
+    if (delta > 0xFFFF)
+    {
+        /* After a long gap the stream catches up over the next records */
+        delta = 0xFFFF;
+        sample->flags |= RT_SENSOR_SAMPLE_FLAG_GAP;
+    }
+    sample->delta = (rt_uint16_t)delta;
+    stream->base_us += delta * 1000;
+
+#ifdef RT_SENSOR_SAMPLE_USING_INT16
+    if (value > RT_SENSOR_SAMPLE_VALUE_MAX)
+    {
+        value = RT_SENSOR_SAMPLE_VALUE_MAX;
+        sample->flags |= RT_SENSOR_SAMPLE_FLAG_CLIPPED;
+    }
+    else if (value < RT_SENSOR_SAMPLE_VALUE_MIN)
+    {
+        value = RT_SENSOR_SAMPLE_VALUE_MIN;
+        sample->flags |= RT_SENSOR_SAMPLE_FLAG_CLIPPED;
+    }
+#endif
+    sample->value = (rt_sensor_sample_value_t)value;
+
+    return RT_EOK;
+}
+
+/*
+ * Convert a compact record of the stream back to a sample. The legacy
+ * 'timestamp' is rebuilt in OS ticks.
+ */
+void rt_sensor_sample_unpack(struct rt_sensor_sample_stream *stream, const struct rt_sensor_sample *sample,
+                             struct rt_sensor_data *data)
+{
+    RT_ASSERT(stream != RT_NULL);
+    RT_ASSERT(sample != RT_NULL);
+    RT_ASSERT(data != RT_NULL);
+
+    stream->base_us += (rt_uint64_t)sample->delta * 1000;
+
+    rt_memset(data, 0, sizeof(struct rt_sensor_data));
+    data->type = sample->channel;
+    data->flags = (sample->flags & RT_SENSOR_SAMPLE_FLAG_EVENT) ? RT_SENSOR_DATA_FLAG_EVENT : 0;
+    data->data.temp = sample->value;
+    data->timestamp_us = stream->base_us;
+    data->timestamp = (rt_uint32_t)(stream->base_us * RT_TICK_PER_SECOND / 1000000);
+}
+
+/* Sensor last sample correlation function */
+
+/*
+ * Publish the latest sample of the sensor. Every path that produces a
+ * sample ends here; interrupts are off so an ISR and a thread never write
+ * at the same time, which keeps the seqlock single-writer.
+ */
+static void sensor_last_update(rt_sensor_t sensor, const struct rt_sensor_data *data)
+{
+    struct rt_sensor_data rec = *data;
+    rt_base_t level;
+
+    sensor_data_stamp(&rec, 1);
+
+    level = rt_hw_interrupt_disable();
+    sensor->last_seq++;
+    SENSOR_BARRIER();
+    sensor->last = rec;
+    SENSOR_BARRIER();
+    sensor->last_seq++;
+    rt_hw_interrupt_enable(level);
+}
+
+/*
+ * Copy the latest sample of the sensor without taking the sensor lock or
+ * touching the bus. Returns -RT_EEMPTY if the sensor has not produced a
+ * sample yet.
+ */
+rt_err_t rt_sensor_get_last(rt_sensor_t sensor, struct rt_sensor_data *data)
+{
+    rt_uint32_t seq;
+
+    RT_ASSERT(sensor != RT_NULL);
+    RT_ASSERT(data != RT_NULL);
+
+    do
+    {
+        seq = sensor->last_seq;
+        if (seq == 0)
+        {
+            return -RT_EEMPTY;
+        }
+        SENSOR_BARRIER();
+        *data = sensor->last;
+        SENSOR_BARRIER();
+        /* Retry if a writer got in while we were copying */
+    } while ((seq & 1) || seq != sensor->last_seq);
+
+    return RT_EOK;
+}
+
+/* The latest sample if it is fresh enough to answer a read without a fetch */
+static rt_bool_t sensor_cache_read(rt_sensor_t sensor, struct rt_sensor_data *data)
+{
+    if (sensor->config.max_age == 0 || rt_sensor_get_last(sensor, data) != RT_EOK)
+    {
+        return RT_FALSE;
+    }
+
+    if (rt_sensor_get_ts_us() - data->timestamp_us > (rt_uint64_t)sensor->config.max_age * 1000)
+    {
+        return RT_FALSE;
+    }
+
+    RT_SENSOR_STATS_INC(sensor, cache_hits);
+    return RT_TRUE;
+}
+
+/*
+ * The lock that serializes the driver calls of a sensor: the module lock,
+ * or the sensor's own one outside a module
+ */
+static rt_mutex_t sensor_lock(rt_sensor_t sensor)
+{
+    return sensor->module ? sensor->module->lock : sensor->lock;
+}
+
+/* Sensor fifo correlation function */
+
+/* 3-axis samples do not fit in a packed slot */
+static rt_bool_t sensor_fifo_can_pack(rt_sensor_t sensor)
+{
+    switch (sensor->info.type)
+    {
+    case RT_SENSOR_CLASS_ACCE:
+    case RT_SENSOR_CLASS_GYRO:
+    case RT_SENSOR_CLASS_MAG:
+        return RT_FALSE;
+    default:
+        return RT_TRUE;
+    }
+}
+
+/* Store a stamped sample in slot 'index' of the ring */
+static void sensor_fifo_put(struct rt_sensor_fifo *fifo, rt_uint32_t index, const struct rt_sensor_data *data)
+{
+    struct rt_sensor_fifo_sample *slot;
+
+    index &= fifo->mask;
+    if (!fifo->packed)
+    {
+        ((struct rt_sensor_data *)fifo->buf)[index] = *data;
+        return;
+    }
+
+    slot = &((struct rt_sensor_fifo_sample *)fifo->buf)[index];
+    slot->timestamp = data->timestamp;
+    slot->timestamp_us_lo = (rt_uint32_t)data->timestamp_us;
+    slot->timestamp_us_hi = (rt_uint16_t)(data->timestamp_us >> 32);
+    slot->type = data->type;
+    slot->flags = data->flags;
+    /* Every scalar member of the data union is a 32-bit integer */
+    slot->value = data->data.temp;
+}
+
+/* Copy slot 'index' of the ring out as a full sample */
+static void sensor_fifo_get(struct rt_sensor_fifo *fifo, rt_uint32_t index, struct rt_sensor_data *data)
+{
+    const struct rt_sensor_fifo_sample *slot;
+
+    index &= fifo->mask;
+    if (!fifo->packed)
+    {
+        *data = ((struct rt_sensor_data *)fifo->buf)[index];
+        return;
+    }
+
+    slot = &((struct rt_sensor_fifo_sample *)fifo->buf)[index];
+    rt_memset(data, 0, sizeof(struct rt_sensor_data));
+    data->timestamp = slot->timestamp;
+    data->timestamp_us = ((rt_uint64_t)slot->timestamp_us_hi << 32) | slot->timestamp_us_lo;
+    data->type = slot->type;
+    data->flags = slot->flags;
+    data->data.temp = slot->value;
+}
+
+static rt_err_t sensor_fifo_alloc(rt_sensor_t sensor, rt_uint32_t depth)
+{
+    struct rt_sensor_subscriber *sub;
+    rt_list_t *node;
+    rt_base_t level;
+    rt_uint32_t size = 1;
+
+    if (depth == 0 || sensor->fifo.buf != RT_NULL)
+    {
+        return RT_EOK;
+    }
+
+    /* Round the ring up to a power of 2 so the counters can wrap freely */
+    while (size < depth)
+    {
+        size <<= 1;
+    }
+
+    sensor->fifo.packed = sensor_fifo_can_pack(sensor);
+    sensor->fifo.buf = rt_malloc((sensor->fifo.packed ? sizeof(struct rt_sensor_fifo_sample) :
+                                  sizeof(struct rt_sensor_data)) * size);
+    if (sensor->fifo.buf == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    sensor->fifo.mask = size - 1;
+    sensor->fifo.in = 0;
+    sensor->fifo.out = 0;
+    sensor->fifo.overflow = 0;
+
+    /* Subscribers that outlived a close start over with the new ring */
+    level = rt_hw_interrupt_disable();
+    rt_list_for_each(node, &sensor->sub_list)
+    {
+        sub = rt_list_entry(node, struct rt_sensor_subscriber, list);
+        sub->cursor = 0;
+        sub->phase = 0;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+static void sensor_fifo_free(rt_sensor_t sensor)
+{
+    void *buf = sensor->fifo.buf;
+
+    if (buf != RT_NULL)
+    {
+        sensor->fifo.buf = RT_NULL;
+        SENSOR_BARRIER();
+        rt_free(buf);
+    }
+}
+
+/*
+ * Number of samples held by the sensor fifo
+ */
+rt_size_t rt_sensor_fifo_len(rt_sensor_t sensor)
+{
+    RT_ASSERT(sensor != RT_NULL);
+
+    if (sensor->fifo.buf == RT_NULL)
+    {
+        return 0;
+    }
+
+    return sensor->fifo.in - sensor->fifo.out;
+}
+
+/*
+ * Append samples to the sensor fifo. This is the producer side and may be
+ * called from an ISR; it never takes the sensor lock. When the ring is full
+ * the unread samples are kept and the new ones are dropped and counted.
+ */
+rt_size_t rt_sensor_fifo_push(rt_sensor_t sensor, const struct rt_sensor_data *data, rt_size_t num)
+{
+    struct rt_sensor_fifo *fifo;
+    struct rt_sensor_data rec;
+    rt_uint32_t in, space, i;
+
+    RT_ASSERT(sensor != RT_NULL);
+    RT_ASSERT(data != RT_NULL);
+
+    if (num == 0)
+    {
+        return 0;
+    }
+
+    /* The newest sample is published even if the ring has no room for it */
+    sensor_last_update(sensor, &data[num - 1]);
+
+    fifo = &sensor->fifo;
+    if (fifo->buf == RT_NULL)
+    {
+        return 0;
+    }
+
+    in = fifo->in;
+    space = fifo->mask + 1 - (in - fifo->out);
+    if (num > space)
+    {
+        fifo->overflow += num - space;
+        num = space;
+    }
+
+    for (i = 0; i < num; i++)
+    {
+        rec = data[i];
+        sensor_data_stamp(&rec, 1);
+        sensor_fifo_put(fifo, in + i, &rec);
+    }
+
+    SENSOR_BARRIER();
+    fifo->in = in + num;
+
+    return num;
+}
+
+/*
+ * Zero-copy read of the sensor fifo. Points *data at the oldest buffered
+ * samples and returns how many of them are contiguous in the ring. The
+ * records stay valid until they are released by rt_sensor_commit(), since
+ * the producer never overwrites unread samples. Call again after a commit
+ * to get the part of the ring that wrapped around. A packed ring has no
+ * full records to point at, its oldest sample is unpacked and handed out
+ * alone.
+ */
+rt_size_t rt_sensor_peek(rt_sensor_t sensor, struct rt_sensor_data **data)
+{
+    struct rt_sensor_fifo *fifo;
+    rt_uint32_t out, start, len;
+
+    RT_ASSERT(sensor != RT_NULL);
+    RT_ASSERT(data != RT_NULL);
+
+    fifo = &sensor->fifo;
+    *data = RT_NULL;
+    if (fifo->buf == RT_NULL)
+    {
+        return 0;
+    }
+
+    out = fifo->out;
+    len = fifo->in - out;
+    SENSOR_BARRIER();
+    if (len == 0)
+    {
+        return 0;
+    }
+
+    if (fifo->packed)
+    {
+        sensor_fifo_get(fifo, out, &fifo->peek);
+        *data = &fifo->peek;
+        return 1;
+    }
+
+    start = out & fifo->mask;
+    if (len > fifo->mask + 1 - start)
+    {
+        len = fifo->mask + 1 - start;
+    }
+    *data = &((struct rt_sensor_data *)fifo->buf)[start];
+
+    return len;
+}
+
+/*
+ * Release num samples obtained by rt_sensor_peek() back to the producer
+ */
+void rt_sensor_commit(rt_sensor_t sensor, rt_size_t num)
+{
+    struct rt_sensor_fifo *fifo;
+
+    RT_ASSERT(sensor != RT_NULL);
+
+    fifo = &sensor->fifo;
+    if (fifo->buf == RT_NULL)
+    {
+        return;
+    }
+
+    if (num > fifo->in - fifo->out)
+    {
+        num = fifo->in - fifo->out;
+    }
+
+    SENSOR_BARRIER();
+    fifo->out += num;
+}
+
+/* Consumer side of the sensor fifo, drains up to len samples in one batch */
+static rt_size_t sensor_fifo_pop(rt_sensor_t sensor, struct rt_sensor_data *data, rt_size_t len)
+{
+    struct rt_sensor_fifo *fifo = &sensor->fifo;
+    struct rt_sensor_data *rec;
+    rt_uint32_t out;
+    rt_size_t num, total = 0;
+
+    /* A packed ring is unpacked straight into the caller's buffer */
+    if (fifo->packed && fifo->buf != RT_NULL)
+    {
+        out = fifo->out;
+        num = fifo->in - out;
+        SENSOR_BARRIER();
+        if (num > len)
+        {
+            num = len;
+        }
+        for (total = 0; total < num; total++)
+        {
+            sensor_fifo_get(fifo, out + total, &data[total]);
+        }
+        rt_sensor_commit(sensor, num);
+
+        return num;
+    }
+
+    /* Copy in at most two runs, the tail of the ring and then its head */
+    while (total < len && (num = rt_sensor_peek(sensor, &rec)) > 0)
+    {
+        if (num > len - total)
+        {
+            num = len - total;
+        }
+        rt_memcpy(data + total, rec, num * sizeof(struct rt_sensor_data));
+        rt_sensor_commit(sensor, num);
+        total += num;
+    }
+
+    return total;
+}
+
+/* Sensor subscriber correlation function */
+
+/* Number of samples in [cursor, in) that the decimation lets through */
+static rt_uint32_t sensor_sub_pending(struct rt_sensor_subscriber *sub, rt_uint32_t in)
+{
+    rt_uint32_t skip, avail;
+
+    skip = (sub->cursor - sub->phase) % sub->decimation;
+    skip = skip ? sub->decimation - skip : 0;
+    avail = in - sub->cursor;
+    if (avail <= skip)
+    {
+        return 0;
+    }
+
+    return (avail - skip - 1) / sub->decimation + 1;
+}
+
+/* Move the fifo read counter up to the slowest subscriber */
+static void sensor_sub_release(rt_sensor_t sensor)
+{
+    struct rt_sensor_subscriber *sub;
+    rt_list_t *node;
+    rt_base_t level;
+    rt_uint32_t in, lag, max_lag = 0;
+
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&sensor->sub_list))
+    {
+        in = sensor->fifo.in;
+        rt_list_for_each(node, &sensor->sub_list)
+        {
+            sub = rt_list_entry(node, struct rt_sensor_subscriber, list);
+            lag = in - sub->cursor;
+            if (lag > max_lag)
+            {
+                max_lag = lag;
+            }
+        }
+        sensor->fifo.out = in - max_lag;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/*
+ * Subscribers are added and removed under this lock, so a notify running
+ * in a thread can walk the list and call them with interrupts enabled.
+ * The list itself is still changed with interrupts off for the notify
+ * that drivers run from an ISR.
+ */
+static rt_mutex_t sensor_sub_lock = RT_NULL;
+
+static int rt_sensor_sub_init(void)
+{
+    sensor_sub_lock = rt_mutex_create("sen_sub", RT_IPC_FLAG_FIFO);
+    if (sensor_sub_lock == RT_NULL)
+    {
+        LOG_E("sensor subscriber lock init failed!");
+        return -RT_ENOMEM;
+    }
+
+    return RT_EOK;
+}
+INIT_PREV_EXPORT(rt_sensor_sub_init);
+
+/* Samples to report to one subscriber */
+static rt_size_t sensor_sub_notify_len(rt_sensor_t sensor, struct rt_sensor_subscriber *sub, rt_size_t len)
+{
+    if (sensor->fifo.buf != RT_NULL && sensor->fifo.in != sub->cursor)
+    {
+        return sensor_sub_pending(sub, sensor->fifo.in);
+    }
+
+    return len;
+}
+
+/*
+ * Tell the consumers of the sensor that data is ready. 'len' is the count
+ * reported to the device reader; a subscriber is told how many samples the
+ * fifo holds for it, or 'len' when nothing new was buffered. A callback
+ * may unsubscribe its own subscriber, but no other one of the sensor.
+ */
+static void sensor_notify(rt_sensor_t sensor, rt_size_t len)
+{
+    struct rt_sensor_subscriber *sub;
+    rt_list_t *node, *next;
+    rt_base_t level;
+    rt_size_t num;
+
+    if (len > 0 && sensor->parent.rx_indicate != RT_NULL)
+    {
+        RT_SENSOR_TRACE(RT_SENSOR_TRACE_RX_INDICATE, sensor, len);
+        sensor->parent.rx_indicate(&sensor->parent, len);
+    }
+
+    if (rt_interrupt_get_nest() == 0 && sensor_sub_lock != RT_NULL)
+    {
+        /* Thread context: the lock keeps the list still, the callbacks run with interrupts on */
+        rt_mutex_take(sensor_sub_lock, RT_WAITING_FOREVER);
+        for (node = sensor->sub_list.next; node != &sensor->sub_list; node = next)
+        {
+            next = node->next;
+            sub = rt_list_entry(node, struct rt_sensor_subscriber, list);
+            num = sensor_sub_notify_len(sensor, sub, len);
+            if (num > 0 && sub->notify != RT_NULL)
+            {
+                sub->notify(sub, num);
+            }
+        }
+        rt_mutex_release(sensor_sub_lock);
+        return;
+    }
+
+    level = rt_hw_interrupt_disable();
+    rt_list_for_each(node, &sensor->sub_list)
+    {
+        sub = rt_list_entry(node, struct rt_sensor_subscriber, list);
+        num = sensor_sub_notify_len(sensor, sub, len);
+        if (num > 0 && sub->notify != RT_NULL)
+        {
+            sub->notify(sub, num);
+        }
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/*
+ * Attach a consumer to the sensor fifo. The subscriber gets one out of
+ * every 'decimation' samples published from now on and 'notify' is called
+ * when some are ready. Any number of subscribers can share one sensor; the
+ * caller owns the subscriber object until rt_sensor_unsubscribe().
+ */
+rt_err_t rt_sensor_subscribe(rt_sensor_t sensor, struct rt_sensor_subscriber *sub, rt_uint16_t decimation,
+                             rt_err_t (*notify)(struct rt_sensor_subscriber *sub, rt_size_t size), void *user_data)
+{
+    rt_base_t level;
+
+    RT_ASSERT(sensor != RT_NULL);
+    RT_ASSERT(sub != RT_NULL);
+
+    sub->sensor = sensor;
+    sub->decimation = decimation > 0 ? decimation : 1;
+    sub->notify = notify;
+    sub->user_data = user_data;
+
+    if (sensor_sub_lock != RT_NULL)
+    {
+        rt_mutex_take(sensor_sub_lock, RT_WAITING_FOREVER);
+    }
+    level = rt_hw_interrupt_disable();
+    sub->cursor = sensor->fifo.in;
+    sub->phase = sub->cursor;
+    rt_list_insert_before(&sensor->sub_list, &sub->list);
+    rt_hw_interrupt_enable(level);
+    if (sensor_sub_lock != RT_NULL)
+    {
+        rt_mutex_release(sensor_sub_lock);
+    }
+
+    /* The direct reader no longer holds samples back once subscribers share the fifo */
+    sensor_sub_release(sensor);
+
+    return RT_EOK;
+}
+
+/*
+ * Detach a consumer from the sensor fifo, releasing what it had not read
+ */
+rt_err_t rt_sensor_unsubscribe(struct rt_sensor_subscriber *sub)
+{
+    rt_base_t level;
+
+    RT_ASSERT(sub != RT_NULL);
+    RT_ASSERT(sub->sensor != RT_NULL);
+
+    if (sensor_sub_lock != RT_NULL)
+    {
+        rt_mutex_take(sensor_sub_lock, RT_WAITING_FOREVER);
+    }
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&sub->list);
+    rt_hw_interrupt_enable(level);
+    if (sensor_sub_lock != RT_NULL)
+    {
+        rt_mutex_release(sensor_sub_lock);
+    }
+
+    sensor_sub_release(sub->sensor);
+    sub->sensor = RT_NULL;
+
+    return RT_EOK;
+}
+
+/*
+ * Copy up to len samples due for the subscriber into buf. A subscriber is
+ * read by one thread only.
+ */
+rt_size_t rt_sensor_subscriber_read(struct rt_sensor_subscriber *sub, struct rt_sensor_data *buf, rt_size_t len)
+{
+    struct rt_sensor_fifo *fifo;
+    rt_uint32_t in, cursor, skip;
+    rt_size_t num = 0;
+
+    RT_ASSERT(sub != RT_NULL);
+    RT_ASSERT(sub->sensor != RT_NULL);
+    RT_ASSERT(buf != RT_NULL);
+
+    fifo = &sub->sensor->fifo;
+    if (fifo->buf == RT_NULL)
+    {
+        return 0;
+    }
+
+    in = fifo->in;
+    SENSOR_BARRIER();
+
+    /* Skip ahead to the first sample the decimation lets through */
+    cursor = sub->cursor;
+    skip = (cursor - sub->phase) % sub->decimation;
+    if (skip)
+    {
+        cursor += sub->decimation - skip;
+    }
+
+    while (num < len && (rt_int32_t)(in - cursor) > 0)
+    {
+        sensor_fifo_get(fifo, cursor, &buf[num++]);
+        cursor += sub->decimation;
+    }
+
+    SENSOR_BARRIER();
+    sub->cursor = (rt_int32_t)(in - cursor) > 0 ? cursor : in;
+    sensor_sub_release(sub->sensor);
+
+    return num;
+}
+
+/* Sensor power management correlation function */
+
+/*
+ * Note the fetch for the idle timeout and power the sensor back up if it
+ * was put to sleep for being idle. The sensor lock is held.
+ */
+static void sensor_pm_wake(rt_sensor_t sensor)
+{
+    if (sensor->config.idle_timeout == 0 || sensor->parent.ref_count == 0)
+    {
+        return;
+    }
+
+    sensor->access_tick = rt_tick_get();
+
+    if (sensor->config.power == RT_SENSOR_POWER_LOW || sensor->config.power == RT_SENSOR_POWER_DOWN)
+    {
+        if (sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, (void *)RT_SENSOR_POWER_NORMAL) == RT_EOK)
+        {
+            sensor->config.power = RT_SENSOR_POWER_NORMAL;
+        }
+    }
+}
+
+/* Sensor statistics correlation function */
+
+#ifdef RT_SENSOR_USING_STATS
+static void sensor_stats_fetch(rt_sensor_t sensor, rt_uint64_t us, rt_size_t res)
+{
+    struct rt_sensor_stats *stats = &sensor->stats;
+    rt_uint32_t bin = 0, t = (us > 0xFFFFFFFF) ? 0xFFFFFFFF : (rt_uint32_t)us;
+
+    stats->fetches++;
+    if (res == 0)
+    {
+        stats->fetch_fails++;
+    }
+    if (t > stats->fetch_us_max)
+    {
+        stats->fetch_us_max = t;
+    }
+    stats->fetch_us_sum += t;
+
+    while ((t >>= 1) != 0 && bin < RT_SENSOR_STATS_HIST_BINS - 1)
+    {
+        bin++;
+    }
+    stats->hist[bin]++;
+}
+#endif
+
+/* Call the driver, every bus access of the framework goes through here */
+static rt_size_t sensor_fetch(rt_sensor_t sensor, void *buf, rt_size_t len)
+{
+    rt_size_t res;
+#ifdef RT_SENSOR_USING_STATS
+    rt_uint64_t start = rt_sensor_get_ts_us();
+#endif
+
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_FETCH_BEGIN, sensor, 0);
+    res = sensor->ops->fetch_data(sensor, buf, len);
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_FETCH_END, sensor, res);
+
+#ifdef RT_SENSOR_USING_STATS
+    sensor_stats_fetch(sensor, rt_sensor_get_ts_us() - start, res);
+#endif
+    return res;
+}
+
+/* A module-wide fetch is booked on the first member, which owns the bus transfer */
+static rt_size_t sensor_fetch_module(struct rt_sensor_module *module, struct rt_sensor_data *data)
+{
+    rt_size_t res;
+#ifdef RT_SENSOR_USING_STATS
+    rt_uint64_t start = rt_sensor_get_ts_us();
+#endif
+
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_FETCH_BEGIN, module->sen[0], 0);
+    res = module->sen[0]->ops->fetch_module(module, data);
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_FETCH_END, module->sen[0], res);
+
+#ifdef RT_SENSOR_USING_STATS
+    sensor_stats_fetch(module->sen[0], rt_sensor_get_ts_us() - start, res);
+#endif
+    return res;
+}
+
+/* Sensor module correlation function */
+
+/*
+ * Take one sample of every member of the module. Drivers that provide
+ * fetch_module pay a single bus transaction for the whole set, others fall
+ * back to one fetch_data per member. The module lock must be held.
+ */
+static rt_size_t sensor_module_fetch(struct rt_sensor_module *module, struct rt_sensor_data *data)
+{
+    rt_sensor_t head = module->sen[0];
+    rt_uint64_t ts, now = 0;
+    rt_size_t i, num = 0;
+
+    for (i = 0; i < module->sen_num; i++)
+    {
+        data[i].type = RT_SENSOR_CLASS_NONE;
+        data[i].timestamp_us = 0;
+        data[i].flags = 0;
+        sensor_pm_wake(module->sen[i]);
+    }
+
+    if (head->ops->fetch_module != RT_NULL)
+    {
+        num = sensor_fetch_module(module, data);
+    }
+    else
+    {
+        for (i = 0; i < module->sen_num; i++)
+        {
+            if (sensor_fetch(module->sen[i], &data[i], 1) == 1)
+            {
+                num++;
+            }
+            else
+            {
+                data[i].type = RT_SENSOR_CLASS_NONE;
+            }
+        }
+    }
+
+    /* All members were flagged by the same interrupt */
+    for (i = 0; i < module->sen_num; i++)
+    {
+        ts = sensor_irq_ts_take(module->sen[i]);
+        if (ts != 0)
+        {
+            now = ts;
+        }
+    }
+    sensor_data_stamp_at(data, module->sen_num, now);
+
+    for (i = 0; i < module->sen_num; i++)
+    {
+        if (data[i].type != RT_SENSOR_CLASS_NONE)
+        {
+            sensor_last_update(module->sen[i], &data[i]);
+        }
+    }
+    module->generation++;
+    module->fetch_tick = rt_tick_get();
+
+    /* Members without a sample in this fetch have nothing to take */
+    for (i = 0; i < module->sen_num; i++)
+    {
+        if (data[i].type == RT_SENSOR_CLASS_NONE)
+        {
+            module->sen[i]->module_gen = module->generation;
+        }
+    }
+
+    return num;
+}
+
+/*
+ * Read a generation-stamped snapshot of all sensors in the module
+ */
+rt_size_t rt_sensor_module_read(struct rt_sensor_module *module, struct rt_sensor_module_snapshot *snap)
+{
+    rt_size_t num;
+
+    RT_ASSERT(module != RT_NULL);
+    RT_ASSERT(snap != RT_NULL);
+
+    rt_mutex_take(module->lock, RT_WAITING_FOREVER);
+
+    num = sensor_module_fetch(module, snap->data);
+    snap->generation = module->generation;
+    snap->num = module->sen_num;
+
+    rt_mutex_release(module->lock);
+
+    return num;
+}
+
+/*
+ * Take the sample a partner's module-wide fetch left for this member in its
+ * latest sample slot. Each generation is handed out once, and only while
+ * the fetch is younger than 'window' ticks, so a reader never gets a sample
+ * it has already seen or one a new fetch would improve on. The module lock
+ * must be held.
+ */
+static rt_bool_t sensor_module_take(rt_sensor_t sensor, struct rt_sensor_data *data, rt_tick_t window)
+{
+    struct rt_sensor_module *module = sensor->module;
+
+    if (sensor->module_gen == module->generation || rt_tick_get() - module->fetch_tick >= window)
+    {
+        return RT_FALSE;
+    }
+
+    if (rt_sensor_get_last(sensor, data) != RT_EOK)
+    {
+        return RT_FALSE;
+    }
+    sensor->module_gen = module->generation;
+
+    return RT_TRUE;
+}
+
+/*
+ * Serve a read of one member from a module-wide fetch. The samples of the
+ * other members stay in their latest sample slots for sensor_module_take();
+ * only subscribers of a partner that is not scheduled get them queued.
+ */
+static rt_size_t sensor_module_read_member(rt_sensor_t sensor, struct rt_sensor_data *buf)
+{
+    struct rt_sensor_module *module = sensor->module;
+    struct rt_sensor_data data[RT_SENSOR_MODULE_MAX];
+    rt_sensor_t member;
+    rt_size_t i, result = 0;
+
+    if (sensor_module_fetch(module, data) == 0)
+    {
+        return 0;
+    }
+    sensor->module_gen = module->generation;
+
+    for (i = 0; i < module->sen_num; i++)
+    {
+        member = module->sen[i];
+        if (data[i].type == RT_SENSOR_CLASS_NONE)
+        {
+            continue;
+        }
+
+        if (member == sensor)
+        {
+            *buf = data[i];
+            result = 1;
+        }
+        else if (member->parent.ref_count > 0 && member->sched_period == 0 &&
+                 !rt_list_isempty(&member->sub_list))
+        {
+            rt_sensor_fifo_push(member, &data[i], 1);
+        }
+    }
+
+    return result;
+}
+
+/* Sensor sampling scheduler correlation function */
+
+/*
+ * One framework thread samples every sensor opened in fifo mode without a
+ * data-ready interrupt, at max(1/odr, period_min), and publishes into the
+ * sensor fifo. The sensors hang off a hashed timer wheel, so a round only
+ * looks at the slot that is due instead of at every scheduled sensor.
+ */
+static rt_list_t   sensor_sched_wheel[SENSOR_SCHED_WHEEL_SIZE];
+static rt_mutex_t  sensor_sched_lock = RT_NULL;
+static rt_sem_t    sensor_sched_sem = RT_NULL;
+static rt_thread_t sensor_sched_thread = RT_NULL;
+static rt_uint32_t sensor_sched_num = 0;
+static rt_tick_t   sensor_sched_slot_tick;
+static rt_list_t   sensor_pm_list;
+
+#define SENSOR_SCHED_SLOT(tick)  (&sensor_sched_wheel[((tick) / sensor_sched_slot_tick) % SENSOR_SCHED_WHEEL_SIZE])
+
+static rt_tick_t sensor_sched_period(rt_sensor_t sensor)
+{
+    rt_uint32_t ms = SENSOR_SCHED_PERIOD_DEFAULT;
+    rt_tick_t tick;
+
+    if (sensor->config.odr > 0)
+    {
+        ms = 1000 / sensor->config.odr;
+    }
+    if (ms < sensor->info.period_min)
+    {
+        ms = sensor->info.period_min;
+    }
+
+    tick = rt_tick_from_millisecond(ms);
+    return tick > 0 ? tick : 1;
+}
+
+static void sensor_sched_sample(rt_sensor_t sensor, rt_tick_t now)
+{
+    struct rt_sensor_data data;
+    rt_size_t res = 0, len;
+
+    rt_mutex_take(sensor_lock(sensor), RT_WAITING_FOREVER);
+
+    data.timestamp_us = 0;
+    data.flags = 0;
+    if (sensor->module && sensor->ops->fetch_module != RT_NULL)
+    {
+        /* A partner's module fetch in this period has already taken our sample */
+        if (sensor_module_take(sensor, &data, sensor->sched_period / 2))
+        {
+            res = 1;
+        }
+        else if (now - sensor->module->fetch_tick >= sensor->sched_period / 2)
+        {
+            res = sensor_module_read_member(sensor, &data);
+        }
+    }
+    else
+    {
+        sensor_pm_wake(sensor);
+        res = sensor_fetch(sensor, &data, 1);
+        sensor_data_stamp(&data, res);
+    }
+
+    if (res == 1)
+    {
+        rt_sensor_fifo_push(sensor, &data, 1);
+    }
+
+    rt_mutex_release(sensor_lock(sensor));
+
+    len = rt_sensor_fifo_len(sensor);
+    if (len > 0)
+    {
+        sensor_notify(sensor, len);
+    }
+}
+
+/* Sample the sensors of one wheel slot that are due, the caller holds the scheduler lock */
+static void sensor_sched_run_slot(rt_tick_t slot, rt_tick_t now)
+{
+    rt_list_t *head = SENSOR_SCHED_SLOT(slot);
+    rt_list_t *node, *next;
+    rt_sensor_t sensor;
+
+    for (node = head->next; node != head; node = next)
+    {
+        next = node->next;
+        sensor = rt_list_entry(node, struct rt_sensor_device, sched_node);
+
+        /* Still some turns of the wheel away */
+        if ((rt_int32_t)(now - sensor->sched_expire) < 0)
+        {
+            continue;
+        }
+
+        rt_list_remove(node);
+        sensor_sched_sample(sensor, now);
+
+        sensor->sched_expire += sensor->sched_period;
+        if ((rt_int32_t)(now - sensor->sched_expire) >= 0)
+        {
+            /* Fell behind, skip the missed periods instead of bursting */
+            sensor->sched_expire = now + sensor->sched_period;
+        }
+        rt_list_insert_before(SENSOR_SCHED_SLOT(sensor->sched_expire), node);
+    }
+}
+
+/*
+ * Power down the open sensors that went idle. Drivers without a low-power
+ * mode are powered down completely. The scheduler lock is held, the sensor
+ * lock is taken after it as when sampling, so the power change does not
+ * cut into a fetch.
+ */
+static void sensor_pm_check(rt_tick_t now)
+{
+    rt_list_t *node;
+    rt_sensor_t sensor;
+
+    rt_list_for_each(node, &sensor_pm_list)
+    {
+        sensor = rt_list_entry(node, struct rt_sensor_device, pm_node);
+        if (sensor->config.power != RT_SENSOR_POWER_NORMAL ||
+            now - sensor->access_tick < rt_tick_from_millisecond(sensor->config.idle_timeout))
+        {
+            continue;
+        }
+
+        rt_mutex_take(sensor_lock(sensor), RT_WAITING_FOREVER);
+
+        if (sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, (void *)RT_SENSOR_POWER_LOW) == RT_EOK)
+        {
+            sensor->config.power = RT_SENSOR_POWER_LOW;
+        }
+        else if (sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, (void *)RT_SENSOR_POWER_DOWN) == RT_EOK)
+        {
+            sensor->config.power = RT_SENSOR_POWER_DOWN;
+        }
+        LOG_D("%s idle, power mode %d", sensor->parent.parent.name, sensor->config.power);
+
+        rt_mutex_release(sensor_lock(sensor));
+    }
+}
+
+/*
+ * Ticks until the earliest scheduled sample, 0 if one is overdue. The
+ * scheduler lock is held.
+ * The slots are looked at in time order from the current one, and the
+ * search stops at the first slot whose end is later than the best found.
+ */
+static rt_int32_t sensor_sched_next(rt_tick_t now)
+{
+    rt_tick_t slot = now - now % sensor_sched_slot_tick;
+    rt_int32_t next = RT_TICK_MAX / 2, delta;
+    rt_list_t *head, *node;
+    rt_sensor_t sensor;
+    int i;
+
+    for (i = 0; i < SENSOR_SCHED_WHEEL_SIZE; i++, slot += sensor_sched_slot_tick)
+    {
+        head = SENSOR_SCHED_SLOT(slot);
+        rt_list_for_each(node, head)
+        {
+            sensor = rt_list_entry(node, struct rt_sensor_device, sched_node);
+            delta = (rt_int32_t)(sensor->sched_expire - now);
+            if (delta < next)
+            {
+                next = delta;
+            }
+        }
+
+        /* Anything in a later slot is due after this one ends */
+        if (next < (rt_int32_t)(slot + sensor_sched_slot_tick - now))
+        {
+            break;
+        }
+    }
+
+    return next > 0 ? next : 0;
+}
+
+static void sensor_sched_entry(void *parameter)
+{
+    rt_tick_t cursor = rt_tick_get();
+    rt_tick_t now;
+    rt_int32_t next;
+    rt_bool_t pm;
+    int i;
+
+    cursor -= cursor % sensor_sched_slot_tick;
+
+    while (1)
+    {
+        rt_mutex_take(sensor_sched_lock, RT_WAITING_FOREVER);
+
+        /* Walk every slot the cursor passed since the last round, one turn of the wheel covers them all */
+        now = rt_tick_get();
+        for (i = 0; i < SENSOR_SCHED_WHEEL_SIZE && (rt_int32_t)(now - cursor) >= 0; i++)
+        {
+            sensor_sched_run_slot(cursor, now);
+            cursor += sensor_sched_slot_tick;
+        }
+        /* Start the next round at the current slot, the rest of it is not due yet */
+        cursor = now - now % sensor_sched_slot_tick;
+
+        next = sensor_sched_num > 0 ? sensor_sched_next(now) : -1;
+
+        sensor_pm_check(now);
+        pm = !rt_list_isempty(&sensor_pm_list);
+
+        rt_mutex_release(sensor_sched_lock);
+
+        /* Sleep until the earliest sample or idle check is due, or the schedule changes */
+        if (pm && (next < 0 || next > (rt_int32_t)rt_tick_from_millisecond(SENSOR_PM_CHECK_MS)))
+        {
+            next = rt_tick_from_millisecond(SENSOR_PM_CHECK_MS);
+        }
+        if (next < 0)
+        {
+            rt_sem_take(sensor_sched_sem, RT_WAITING_FOREVER);
+        }
+        else if (next > 0)
+        {
+            rt_sem_take(sensor_sched_sem, next);
+        }
+    }
+}
+
+static int rt_sensor_sched_init(void)
+{
+    int i;
+
+    for (i = 0; i < SENSOR_SCHED_WHEEL_SIZE; i++)
+    {
+        rt_list_init(&sensor_sched_wheel[i]);
+    }
+    rt_list_init(&sensor_pm_list);
+
+    sensor_sched_slot_tick = rt_tick_from_millisecond(SENSOR_SCHED_SLOT_MS);
+    if (sensor_sched_slot_tick == 0)
+    {
+        sensor_sched_slot_tick = 1;
+    }
+
+    sensor_sched_lock = rt_mutex_create("sen_sch", RT_IPC_FLAG_FIFO);
+    sensor_sched_sem = rt_sem_create("sen_sch", 0, RT_IPC_FLAG_FIFO);
+    if (sensor_sched_lock == RT_NULL || sensor_sched_sem == RT_NULL)
+    {
+        LOG_E("sensor scheduler init failed!");
+        return -RT_ENOMEM;
+    }
+
+    return RT_EOK;
+}
+INIT_PREV_EXPORT(rt_sensor_sched_init);
+
+/*
+ * Let the framework sample the sensor periodically and publish into its fifo
+ */
+/* The thread is only created once a sensor needs it, the scheduler lock is held */
+static rt_err_t sensor_sched_thread_start(void)
+{
+    if (sensor_sched_thread == RT_NULL)
+    {
+        sensor_sched_thread = rt_thread_create("sen_sch", sensor_sched_entry, RT_NULL,
+                                               RT_SENSOR_SCHED_THREAD_STACK_SIZE,
+                                               RT_SENSOR_SCHED_THREAD_PRIORITY, 10);
+        if (sensor_sched_thread == RT_NULL)
+        {
+            return -RT_ENOMEM;
+        }
+        rt_thread_startup(sensor_sched_thread);
+    }
+
+    return RT_EOK;
+}
+
+rt_err_t rt_sensor_sched_start(rt_sensor_t sensor)
+{
+    RT_ASSERT(sensor != RT_NULL);
+
+    if (sensor_sched_lock == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(sensor_sched_lock, RT_WAITING_FOREVER);
+
+    if (sensor_sched_thread_start() != RT_EOK)
+    {
+        rt_mutex_release(sensor_sched_lock);
+        return -RT_ENOMEM;
+    }
+
+    if (sensor->sched_period != 0)
+    {
+        /* Already scheduled, pick up the new period */
+        rt_list_remove(&sensor->sched_node);
+    }
+    else
+    {
+        sensor_sched_num++;
+    }
+
+    sensor->sched_period = sensor_sched_period(sensor);
+    sensor->sched_expire = rt_tick_get();
+    rt_list_insert_before(SENSOR_SCHED_SLOT(sensor->sched_expire), &sensor->sched_node);
+
+    rt_mutex_release(sensor_sched_lock);
+
+    rt_sem_release(sensor_sched_sem);
+
+    LOG_D("%s scheduled every %d ticks", sensor->parent.parent.name, sensor->sched_period);
+
+    return RT_EOK;
+}
+
+/*
+ * Stop the periodic sampling of the sensor
+ */
+rt_err_t rt_sensor_sched_stop(rt_sensor_t sensor)
+{
+    RT_ASSERT(sensor != RT_NULL);
+
+    if (sensor_sched_lock == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(sensor_sched_lock, RT_WAITING_FOREVER);
+
+    if (sensor->sched_period != 0)
+    {
+        rt_list_remove(&sensor->sched_node);
+        sensor->sched_period = 0;
+        sensor_sched_num--;
+    }
+
+    rt_mutex_release(sensor_sched_lock);
+
+    return RT_EOK;
+}
+
+/*
+ * Put the sensor under idle power management if it has an idle timeout,
+ * or take it off. Called outside the sensor lock.
+ * Interrupt-driven sensors are left out: they only wake up on a read, and
+ * a sleeping sensor raises no interrupt that would lead to one.
+ */
+static rt_err_t sensor_pm_update(rt_sensor_t sensor, rt_bool_t open)
+{
+    rt_err_t result = RT_EOK;
+
+    if (sensor_sched_lock == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(sensor_sched_lock, RT_WAITING_FOREVER);
+
+    rt_list_remove(&sensor->pm_node);
+    if (open && sensor->config.idle_timeout != 0 &&
+        sensor->config.mode != RT_SENSOR_MODE_INT && sensor->config.mode != RT_SENSOR_MODE_FIFO)
+    {
+        result = sensor_sched_thread_start();
+        if (result == RT_EOK)
+        {
+            sensor->access_tick = rt_tick_get();
+            rt_list_insert_before(&sensor_pm_list, &sensor->pm_node);
+        }
+    }
+
+    rt_mutex_release(sensor_sched_lock);
+
+    /* Let the thread pick up the new idle check interval */
+    rt_sem_release(sensor_sched_sem);
+
+    return result;
+}
+
+/* Sensor interrupt correlation function */
+/*
+ * Sensor interrupt handler function. It runs in the irq worker thread for
+ * interrupts of the framework, drivers may still call it from an ISR.
+ */
+void rt_sensor_cb(rt_sensor_t sen)
+{
+    rt_size_t len;
+
+    if (sen->parent.rx_indicate == RT_NULL && rt_list_isempty(&sen->sub_list))
+    {
+        return;
+    }
+
+    if (sen->irq_handle != RT_NULL)
+    {
+        sen->irq_handle(sen);
+    }
+
+    /* The buffer is not empty. Read the data in the buffer first */
+    len = rt_sensor_fifo_len(sen);
+    if (len == 0 && sen->config.mode == RT_SENSOR_MODE_INT)
+    {
+        /* The interrupt mode only produces one data at a time */
+        len = 1;
+    }
+    else if (len == 0 && sen->config.mode == RT_SENSOR_MODE_FIFO)
+    {
+        len = sen->info.fifo_max;
+    }
+
+    sensor_notify(sen, len);
+}
+
+/*
+ * The ISR only records which sensors raised an interrupt and when. One
+ * worker thread runs the driver irq_handle and the consumer callbacks, so
+ * the time spent in the ISR does not grow with the sensors and subscribers
+ * on a pin, and a burst of edges before the worker runs is dispatched once.
+ */
+static rt_list_t   sensor_irq_list;
+static rt_mutex_t  sensor_irq_lock = RT_NULL;
+static rt_sem_t    sensor_irq_sem = RT_NULL;
+static rt_thread_t sensor_irq_thread = RT_NULL;
+
+/* Queue the sensor for the worker, interrupts are disabled */
+static void sensor_irq_defer(rt_sensor_t sensor, rt_uint64_t now)
+{
+    sensor->irq_ts_us = now;
+    if (!sensor->irq_pending)
+    {
+        sensor->irq_pending = 1;
+        rt_list_insert_before(&sensor_irq_list, &sensor->irq_node);
+    }
+}
+
+static void sensor_irq_entry(void *parameter)
+{
+    rt_sensor_t sensor;
+    rt_base_t level;
+
+    while (1)
+    {
+        rt_sem_take(sensor_irq_sem, RT_WAITING_FOREVER);
+
+        /* Drain the list, edges arriving meanwhile are picked up in this round */
+        while (1)
+        {
+            level = rt_hw_interrupt_disable();
+            if (rt_list_isempty(&sensor_irq_list))
+            {
+                rt_hw_interrupt_enable(level);
+                break;
+            }
+            sensor = rt_list_entry(sensor_irq_list.next, struct rt_sensor_device, irq_node);
+            rt_list_remove(&sensor->irq_node);
+            sensor->irq_pending = 0;
+            rt_hw_interrupt_enable(level);
+
+            /* Closed after the edge was queued, rt_sensor_close drops the rest */
+            if (sensor->parent.ref_count > 0)
+            {
+                rt_sensor_cb(sensor);
+            }
+        }
+    }
+}
+
+static rt_err_t sensor_irq_worker_start(void)
+{
+    rt_thread_t tid;
+
+    if (sensor_irq_lock == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(sensor_irq_lock, RT_WAITING_FOREVER);
+
+    /* The thread is only created once a sensor uses its interrupt */
+    if (sensor_irq_thread == RT_NULL)
+    {
+        tid = rt_thread_create("sen_irq", sensor_irq_entry, RT_NULL,
+                               RT_SENSOR_IRQ_THREAD_STACK_SIZE,
+                               RT_SENSOR_IRQ_THREAD_PRIORITY, 10);
+        if (tid == RT_NULL)
+        {
+            rt_mutex_release(sensor_irq_lock);
+            return -RT_ENOMEM;
+        }
+        rt_thread_startup(tid);
+        sensor_irq_thread = tid;
+    }
+
+    rt_mutex_release(sensor_irq_lock);
+
+    return RT_EOK;
+}
+
+static int rt_sensor_irq_worker_init(void)
+{
+    rt_list_init(&sensor_irq_list);
+
+    sensor_irq_lock = rt_mutex_create("sen_irq", RT_IPC_FLAG_FIFO);
+    sensor_irq_sem = rt_sem_create("sen_irq", 0, RT_IPC_FLAG_FIFO);
+    if (sensor_irq_lock == RT_NULL || sensor_irq_sem == RT_NULL)
+    {
+        LOG_E("sensor irq worker init failed!");
+        return -RT_ENOMEM;
+    }
+
+    return RT_EOK;
+}
+INIT_PREV_EXPORT(rt_sensor_irq_worker_init);
+
+/* ISR for sensor interrupt */
+static void irq_callback(void *args)
+{
+    rt_sensor_t sensor = (rt_sensor_t)args;
+    rt_uint64_t now;
+    rt_base_t level;
+    rt_bool_t idle;
+    rt_uint8_t i;
+
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_IRQ, sensor, 0);
+
+    if (sensor_irq_thread == RT_NULL)
+    {
+        /* No worker, dispatch from the ISR */
+        if (sensor->module)
+        {
+            for (i = 0; i < sensor->module->sen_num; i++)
+            {
+                if (sensor->module->sen[i]->parent.ref_count > 0)
+                {
+                    rt_sensor_cb(sensor->module->sen[i]);
+                }
+            }
+        }
+        else
+        {
+            rt_sensor_cb(sensor);
+        }
+        return;
+    }
+
+    now = rt_sensor_get_ts_us();
+
+    level = rt_hw_interrupt_disable();
+    idle = rt_list_isempty(&sensor_irq_list);
+    if (sensor->module)
+    {
+        /* Flag all open sensors in the module */
+        for (i = 0; i < sensor->module->sen_num; i++)
+        {
+            if (sensor->module->sen[i]->parent.ref_count > 0)
+            {
+                sensor_irq_defer(sensor->module->sen[i], now);
+            }
+        }
+    }
+    else
+    {
+        sensor_irq_defer(sensor, now);
+    }
+    rt_hw_interrupt_enable(level);
+
+    /* A non-empty list means the worker is already due */
+    if (idle)
+    {
+        rt_sem_release(sensor_irq_sem);
+    }
+}
+
+/* Sensor interrupt initialization function */
+/* Another open member of the module still takes interrupts from the same pin */
+static rt_bool_t sensor_irq_pin_shared(rt_sensor_t sensor)
+{
+    rt_sensor_t member;
+    int i;
+
+    if (sensor->module == RT_NULL)
+    {
+        return RT_FALSE;
+    }
+
+    for (i = 0; i < sensor->module->sen_num; i++)
+    {
+        member = sensor->module->sen[i];
+        if (member != sensor && member->parent.ref_count > 0 &&
+            member->config.irq_pin.pin == sensor->config.irq_pin.pin &&
+            (member->config.mode == RT_SENSOR_MODE_INT || member->config.mode == RT_SENSOR_MODE_FIFO))
+        {
+            return RT_TRUE;
+        }
+    }
+
+    return RT_FALSE;
+}
+
+static rt_err_t rt_sensor_irq_init(rt_sensor_t sensor)
+{
+    rt_err_t result = -RT_EINVAL;
+
+    if (sensor->config.irq_pin.pin == RT_PIN_NONE)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* The partner's handler already flags the whole module */
+    if (sensor_irq_pin_shared(sensor))
+    {
+        return RT_EOK;
+    }
+
+    if (sensor_irq_worker_start() != RT_EOK)
+    {
+        LOG_W("no irq worker, callbacks run in the ISR");
+    }
+
+    rt_pin_mode(sensor->config.irq_pin.pin, sensor->config.irq_pin.mode);
+
+    if (sensor->config.irq_pin.mode == PIN_MODE_INPUT_PULLDOWN)
+    {
+        result = rt_pin_attach_irq(sensor->config.irq_pin.pin, PIN_IRQ_MODE_RISING, irq_callback, (void *)sensor);
+    }
+    else if (sensor->config.irq_pin.mode == PIN_MODE_INPUT_PULLUP)
+    {
+        result = rt_pin_attach_irq(sensor->config.irq_pin.pin, PIN_IRQ_MODE_FALLING, irq_callback, (void *)sensor);
+    }
+    else if (sensor->config.irq_pin.mode == PIN_MODE_INPUT)
+    {
+        result = rt_pin_attach_irq(sensor->config.irq_pin.pin, PIN_IRQ_MODE_RISING_FALLING, irq_callback, (void *)sensor);
+    }
+    if (result != RT_EOK)
+    {
+        LOG_E("interrupt init failed on pin %d", sensor->config.irq_pin.pin);
+        return result;
+    }
+
+    rt_pin_irq_enable(sensor->config.irq_pin.pin, RT_TRUE);
+
+    LOG_I("interrupt init success");
+
+    return RT_EOK;
+}
+
+/* RT-Thread Device Interface */
+static rt_err_t rt_sensor_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    rt_sensor_t sensor = (rt_sensor_t)dev;
+    RT_ASSERT(dev != RT_NULL);
+    rt_err_t res = RT_EOK;
+    rt_bool_t sched = RT_FALSE;
+
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_OPEN, sensor, oflag);
+
+    /* take the sensor mutex */
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_LOCK_BEGIN, sensor, 0);
+    rt_mutex_take(sensor_lock(sensor), RT_WAITING_FOREVER);
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_LOCK_END, sensor, 0);
+
+    /* Allocate memory for the sensor buffer */
+    if (sensor_fifo_alloc(sensor, sensor->info.fifo_max) != RT_EOK)
+    {
+        res = -RT_ENOMEM;
+        goto __exit;
+    }
+
+    if (oflag & RT_DEVICE_FLAG_RDONLY && dev->flag & RT_DEVICE_FLAG_RDONLY)
+    {
+        if (sensor->ops->control != RT_NULL)
+        {
+            /* If polling mode is supported, configure it to polling mode */
+            sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_MODE, (void *)RT_SENSOR_MODE_POLLING);
+        }
+        sensor->config.mode = RT_SENSOR_MODE_POLLING;
+    }
+    else if (oflag & RT_DEVICE_FLAG_INT_RX && dev->flag & RT_DEVICE_FLAG_INT_RX)
+    {
+        /* Initialization sensor interrupt, there is no interrupt mode without the pin */
+        res = rt_sensor_irq_init(sensor);
+        if (res != RT_EOK)
+        {
+            goto __exit;
+        }
+        if (sensor->ops->control != RT_NULL)
+        {
+            /* If interrupt mode is supported, configure it to interrupt mode */
+            sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_MODE, (void *)RT_SENSOR_MODE_INT);
+        }
+        sensor->config.mode = RT_SENSOR_MODE_INT;
+    }
+    else if (oflag & RT_DEVICE_FLAG_FIFO_RX && dev->flag & RT_DEVICE_FLAG_FIFO_RX &&
+             sensor->config.irq_pin.pin == RT_PIN_NONE)
+    {
+        /* No data-ready line: the driver is polled by the sampling scheduler, which fills the fifo */
+        if (sensor->ops->control != RT_NULL)
+        {
+            sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_MODE, (void *)RT_SENSOR_MODE_POLLING);
+        }
+        sensor->config.mode = RT_SENSOR_MODE_POLLING;
+        sched = RT_TRUE;
+
+        /* Sensors without a hardware fifo still need a ring to publish into */
+        if (sensor_fifo_alloc(sensor, SENSOR_SCHED_FIFO_DEPTH) != RT_EOK)
+        {
+            res = -RT_ENOMEM;
+            goto __exit;
+        }
+    }
+    else if (oflag & RT_DEVICE_FLAG_FIFO_RX && dev->flag & RT_DEVICE_FLAG_FIFO_RX)
+    {
+        /* Initialization sensor interrupt */
+        res = rt_sensor_irq_init(sensor);
+        if (res != RT_EOK)
+        {
+            goto __exit;
+        }
+        if (sensor->ops->control != RT_NULL)
+        {
+            /* If fifo mode is supported, configure it to fifo mode */
+            sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_MODE, (void *)RT_SENSOR_MODE_FIFO);
+        }
+        sensor->config.mode = RT_SENSOR_MODE_FIFO;
+    }
+    else
+    {
+        res = -RT_EINVAL;
+        goto __exit;
+    }
+
+    /* Configure power mode to normal mode */
+    if (sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, (void *)RT_SENSOR_POWER_NORMAL) == RT_EOK)
+    {
+        sensor->config.power = RT_SENSOR_POWER_NORMAL;
+    }
+
+__exit:
+    /* release the sensor mutex */
+    rt_mutex_release(sensor_lock(sensor));
+
+    /* Outside the sensor lock, the scheduler takes it while sampling */
+    if (res == RT_EOK && sched)
+    {
+        res = rt_sensor_sched_start(sensor);
+    }
+    if (res == RT_EOK)
+    {
+        sensor_pm_update(sensor, RT_TRUE);
+    }
+
+    return res;
+}
+
+static rt_err_t rt_sensor_close(rt_device_t dev)
+{
+    rt_sensor_t sensor = (rt_sensor_t)dev;
+    rt_base_t level;
+    int i;
+
+    RT_ASSERT(dev != RT_NULL);
+
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_CLOSE, sensor, 0);
+
+    /* Before the sensor lock, the scheduler takes it while sampling */
+    rt_sensor_sched_stop(sensor);
+    sensor_pm_update(sensor, RT_FALSE);
+
+    rt_mutex_take(sensor_lock(sensor), RT_WAITING_FOREVER);
+
+    /* Configure power mode to power down mode */
+    if (sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, (void *)RT_SENSOR_POWER_DOWN) == RT_EOK)
+    {
+        sensor->config.power = RT_SENSOR_POWER_DOWN;
+    }
+
+    /* Sensor disable interrupt, unless an open partner shares the line (e.g. the CCS811 nINT) */
+    if (sensor->config.irq_pin.pin != RT_PIN_NONE &&
+        (sensor->config.mode == RT_SENSOR_MODE_INT || sensor->config.mode == RT_SENSOR_MODE_FIFO) &&
+        !sensor_irq_pin_shared(sensor))
+    {
+        rt_pin_irq_enable(sensor->config.irq_pin.pin, RT_FALSE);
+        rt_pin_detach_irq(sensor->config.irq_pin.pin);
+    }
+
+    /* Drop an edge still queued for the irq worker, a closed sensor gets no callbacks */
+    level = rt_hw_interrupt_disable();
+    if (sensor->irq_pending)
+    {
+        rt_list_remove(&sensor->irq_node);
+        sensor->irq_pending = 0;
+    }
+    sensor->irq_ts_us = 0;
+    rt_hw_interrupt_enable(level);
+
+    if (sensor->module != RT_NULL)
+    {
+        /* Module members feed each other's buffers, keep them until all are closed */
+        for (i = 0; i < sensor->module->sen_num; i ++)
+        {
+            if (sensor->module->sen[i]->parent.ref_count > 0)
+                goto __exit;
+        }
+
+        /* Free memory for the sensor buffer */
+        for (i = 0; i < sensor->module->sen_num; i ++)
+        {
+            sensor_fifo_free(sensor->module->sen[i]);
+        }
+    }
+    else
+    {
+        sensor_fifo_free(sensor);
+    }
+
+__exit:
+    rt_mutex_release(sensor_lock(sensor));
+
+    return RT_EOK;
+}
+
+static rt_size_t rt_sensor_read(rt_device_t dev, rt_off_t pos, void *buf, rt_size_t len)
+{
+    rt_sensor_t sensor = (rt_sensor_t)dev;
+    rt_size_t result = 0;
+    RT_ASSERT(dev != RT_NULL);
+
+    if (buf == NULL || len == 0)
+    {
+        return 0;
+    }
+    RT_SENSOR_STATS_INC(sensor, reads);
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_READ_BEGIN, sensor, len);
+
+    /* A fresh cached sample needs neither the lock nor the bus */
+    if ((!rt_list_isempty(&sensor->sub_list) || rt_sensor_fifo_len(sensor) == 0) &&
+        sensor_cache_read(sensor, (struct rt_sensor_data *)buf))
+    {
+        RT_SENSOR_RECORD(sensor, (struct rt_sensor_data *)buf, 1);
+        RT_SENSOR_TRACE(RT_SENSOR_TRACE_READ_END, sensor, 1);
+        return 1;
+    }
+
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_LOCK_BEGIN, sensor, 0);
+    rt_mutex_take(sensor_lock(sensor), RT_WAITING_FOREVER);
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_LOCK_END, sensor, 0);
+
+    /* The buffer is not empty. Read the data in the buffer first, unless subscribers share it */
+    if (rt_list_isempty(&sensor->sub_list) && rt_sensor_fifo_len(sensor) > 0)
+    {
+        result = sensor_fifo_pop(sensor, buf, len);
+    }
+    else if (sensor->sched_period != 0)
+    {
+        /* The scheduler owns the bus access of this sensor, wait for its next sample */
+        result = 0;
+    }
+    else if (sensor_cache_read(sensor, (struct rt_sensor_data *)buf))
+    {
+        /* Another reader fetched while we were waiting for the lock */
+        result = 1;
+    }
+    else
+    {
+        struct rt_sensor_data *data = (struct rt_sensor_data *)buf;
+        rt_size_t i;
+
+        /* Let the framework stamp the records the driver leaves unstamped */
+        for (i = 0; i < len; i++)
+        {
+            data[i].timestamp_us = 0;
+            data[i].flags = 0;
+        }
+
+        /* If the buffer is empty read the data */
+        if (sensor->module && sensor->ops->fetch_module != RT_NULL)
+        {
+            /* The chip has no newer sample than a partner's fetch within the module window */
+            rt_tick_t window = rt_tick_from_millisecond(sensor->module->window ? sensor->module->window : sensor->info.period_min);
+
+            if (sensor_module_take(sensor, data, window > 0 ? window : 1))
+            {
+                result = 1;
+            }
+            else
+            {
+                result = sensor_module_read_member(sensor, data);
+            }
+        }
+        else
+        {
+            sensor_pm_wake(sensor);
+            result = sensor_fetch(sensor, buf, len);
+            sensor_data_stamp_at(data, result, sensor_irq_ts_take(sensor));
+            if (result > 0)
+            {
+                sensor_last_update(sensor, &data[result - 1]);
+            }
+        }
+    }
+
+    rt_mutex_release(sensor_lock(sensor));
+
+    RT_SENSOR_RECORD(sensor, (struct rt_sensor_data *)buf, result);
+    RT_SENSOR_TRACE(RT_SENSOR_TRACE_READ_END, sensor, result);
+    return result;
+}
+
+static rt_err_t rt_sensor_control(rt_device_t dev, int cmd, void *args)
+{
+    rt_sensor_t sensor = (rt_sensor_t)dev;
+    rt_err_t result = RT_EOK;
+    RT_ASSERT(dev != RT_NULL);
+
+    /* The sensor info does not change after registration, no lock needed */
+    if (cmd == RT_SENSOR_CTRL_GET_INFO)
+    {
+        if (args)
+        {
+            rt_memcpy(args, &sensor->info, sizeof(struct rt_sensor_info));
+        }
+        return RT_EOK;
+    }
+
+    rt_mutex_take(sensor_lock(sensor), RT_WAITING_FOREVER);
+
+    switch (cmd)
+    {
+    case RT_SENSOR_CTRL_GET_ID:
+        if (args)
+        {
+            sensor->ops->control(sensor, RT_SENSOR_CTRL_GET_ID, args);
+        }
+        break;
+    case RT_SENSOR_CTRL_SET_RANGE:
+
+        /* Configuration measurement range */
+        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_RANGE, args);
+        if (result == RT_EOK)
+        {
+            sensor->config.range = (rt_base_t)args;
+            LOG_D("set range %d", sensor->config.range);
+        }
+        break;
+    case RT_SENSOR_CTRL_SET_ODR:
+
+        /* Configuration data output rate */
+        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_ODR, args);
+        if (result == RT_EOK || sensor->sched_period != 0)
+        {
+            /* A scheduled sensor is paced by the framework, whatever the driver supports */
+            sensor->config.odr = (rt_base_t)args & 0xFFFF;
+            LOG_D("set odr %d", sensor->config.odr);
+            result = RT_EOK;
+        }
+        break;
+    case RT_SENSOR_CTRL_SET_POWER:
+
+        /* Configuration sensor power mode */
+        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SET_POWER, args);
+        if (result == RT_EOK)
+        {
+            sensor->config.power = (rt_base_t)args & 0xFF;
+            LOG_D("set power mode code:", sensor->config.power);
+        }
+        break;
+    case RT_SENSOR_CTRL_SELF_TEST:
+
+        /* Device self-test */
+        result = sensor->ops->control(sensor, RT_SENSOR_CTRL_SELF_TEST, args);
+        break;
+    case RT_SENSOR_CTRL_SET_IDLE_TIMEOUT:
+
+        /* Handled by the framework, a sensor put to sleep is woken when management stops */
+        if ((rt_base_t)args == 0)
+        {
+            sensor_pm_wake(sensor);
+        }
+        sensor->config.idle_timeout = (rt_base_t)args;
+        LOG_D("set idle timeout %dms", sensor->config.idle_timeout);
+        break;
+    case RT_SENSOR_CTRL_SET_MAX_AGE:
+
+        /* Handled by the framework, the driver is not involved */
+        sensor->config.max_age = (rt_base_t)args;
+        LOG_D("set max age %dms", sensor->config.max_age);
+        break;
+    default:
+
+        /* Driver specific commands */
+        result = sensor->ops->control(sensor, cmd, args);
+        break;
+    }
+
+    rt_mutex_release(sensor_lock(sensor));
+
+    if (cmd == RT_SENSOR_CTRL_SET_ODR && result == RT_EOK && sensor->sched_period != 0)
+    {
+        /* Reschedule with the new period */
+        rt_sensor_sched_start(sensor);
+    }
+    else if (cmd == RT_SENSOR_CTRL_SET_IDLE_TIMEOUT)
+    {
+        sensor_pm_update(sensor, dev->ref_count > 0);
+    }
+
+    return result;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops rt_sensor_ops =
+{
+    RT_NULL,
+    rt_sensor_open,
+    rt_sensor_close,
+    rt_sensor_read,
+    RT_NULL,
+    rt_sensor_control
+};
+#endif
+
+/*
+ * sensor register
+ */
+//int rt_hw_aht10_init(const char* name, struct rt_sensor_config* cfg)
+
+int rt_hw_sensor_register(rt_sensor_t sensor,
+                          const char              *name,
+                          rt_uint32_t              flag,
+                          void                    *data)
+{
+    rt_int8_t result;
+    rt_device_t device;
+    RT_ASSERT(sensor != RT_NULL);
+
+    char device_name[RT_NAME_MAX + 1];
+
+    if (sensor->info.type >= RT_SENSOR_CLASS_MAX)
+    {
+        LOG_E("unknown sensor type: %d", sensor->info.type);
+        return -RT_EINVAL;
+    }
+
+    /* Add a type name for the sensor device, the device object keeps a copy of it */
+    rt_snprintf(device_name, sizeof(device_name), "%s%s", sensor_name_str[sensor->info.type], name);
+
+    if (sensor->module != RT_NULL && sensor->module->lock == RT_NULL)
+    {
+        /* Create a mutex lock for the module */
+        sensor->module->lock = rt_mutex_create(name, RT_IPC_FLAG_FIFO);
+        if (sensor->module->lock == RT_NULL)
+        {
+            return -RT_ERROR;
+        }
+    }
+    else if (sensor->module == RT_NULL)
+    {
+        /* Create a mutex lock for the sensor */
+        sensor->lock = rt_mutex_create(name, RT_IPC_FLAG_FIFO);
+        if (sensor->lock == RT_NULL)
+        {
+            return -RT_ERROR;
+        }
+    }
+
+    rt_list_init(&sensor->sched_node);
+    rt_list_init(&sensor->sub_list);
+    rt_list_init(&sensor->irq_node);
+    rt_list_init(&sensor->pm_node);
+
+    device = &sensor->parent;
+
+#ifdef RT_USING_DEVICE_OPS
+    device->ops         = &rt_sensor_ops;
+#else
+    device->init        = RT_NULL;
+    device->open        = rt_sensor_open;
+    device->close       = rt_sensor_close;
+    device->read        = rt_sensor_read;
+    device->write       = RT_NULL;
+    device->control     = rt_sensor_control;
+#endif
+    device->type        = RT_Device_Class_Sensor;
+    device->rx_indicate = RT_NULL;
+    device->tx_complete = RT_NULL;
+    device->user_data   = data;
+
+    result = rt_device_register(device, device_name, flag | RT_DEVICE_FLAG_STANDALONE);
+    if (result != RT_EOK)
+    {
+        LOG_E("rt_sensor register err code: %d", result);
+        return result;
+    }
+
+    sensor_registry_add(sensor);
+
+    LOG_I("rt_sensor init success");
+    return RT_EOK;
+}
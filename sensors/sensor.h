@@ -1,223 +1,528 @@
-/*
- * Copyright (c) 2006-2018, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author       Notes
- * 2019-01-31     flybreak     first version
- */
-
-#ifndef __SENSOR_H__
-#define __SENSOR_H__
-
-#include <rtthread.h>
-#include <rtdevice.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-#ifdef RT_USING_RTC
-#define  rt_sensor_get_ts()  time(RT_NULL)   /* API for the sensor to get the timestamp */
-#else
-#define  rt_sensor_get_ts()  rt_tick_get()   /* API for the sensor to get the timestamp */
-#endif
-
-#define  RT_PIN_NONE                   0xFFFF    /* RT PIN NONE */
-#define  RT_DEVICE_FLAG_FIFO_RX        0x200     /* Flag to use when the sensor is open by fifo mode */
-
-#define  RT_SENSOR_MODULE_MAX          (3)       /* The maximum number of members of a sensor module */
-
-/* Sensor types */
-
-#define RT_SENSOR_CLASS_NONE           (0)
-#define RT_SENSOR_CLASS_ACCE           (1)  /* Accelerometer     */
-#define RT_SENSOR_CLASS_GYRO           (2)  /* Gyroscope         */
-#define RT_SENSOR_CLASS_MAG            (3)  /* Magnetometer      */
-#define RT_SENSOR_CLASS_TEMP           (4)  /* Temperature       */
-#define RT_SENSOR_CLASS_HUMI           (5)  /* Relative Humidity */
-#define RT_SENSOR_CLASS_BARO           (6)  /* Barometer         */
-#define RT_SENSOR_CLASS_LIGHT          (7)  /* Ambient light     */
-#define RT_SENSOR_CLASS_PROXIMITY      (8)  /* Proximity         */
-#define RT_SENSOR_CLASS_HR             (9)  /* Heart Rate        */
-#define RT_SENSOR_CLASS_TVOC           (10) /* TVOC Level        */
-#define RT_SENSOR_CLASS_NOISE          (11) /* Noise Loudness    */
-#define RT_SENSOR_CLASS_STEP           (12) /* Step sensor       */
-#define RT_SENSOR_CLASS_FORCE          (13) /* Force sensor      */
-//add
-#define RT_SENSOR_CLASS_ECO2           (14) /* CO2 Level        */    
-
-/* Sensor vendor types */
-
-#define RT_SENSOR_VENDOR_UNKNOWN       (0)
-#define RT_SENSOR_VENDOR_STM           (1)  /* STMicroelectronics */
-#define RT_SENSOR_VENDOR_BOSCH         (2)  /* Bosch */
-#define RT_SENSOR_VENDOR_INVENSENSE    (3)  /* Invensense */
-#define RT_SENSOR_VENDOR_SEMTECH       (4)  /* Semtech */
-#define RT_SENSOR_VENDOR_GOERTEK       (5)  /* Goertek */
-#define RT_SENSOR_VENDOR_MIRAMEMS      (6)  /* MiraMEMS */
-#define RT_SENSOR_VENDOR_DALLAS        (7)  /* Dallas */
-//add
-#define RT_SENSOR_VENDOR_AMS        (8)  /* Dallas */
-
-/* Sensor unit types */
-
-#define  RT_SENSOR_UNIT_NONE           (0)
-#define  RT_SENSOR_UNIT_MG             (1)  /* Accelerometer           unit: mG         */
-#define  RT_SENSOR_UNIT_MDPS           (2)  /* Gyroscope               unit: mdps       */
-#define  RT_SENSOR_UNIT_MGAUSS         (3)  /* Magnetometer            unit: mGauss     */
-#define  RT_SENSOR_UNIT_LUX            (4)  /* Ambient light           unit: lux        */
-#define  RT_SENSOR_UNIT_CM             (5)  /* Distance                unit: cm         */
-#define  RT_SENSOR_UNIT_PA             (6)  /* Barometer               unit: pa         */
-#define  RT_SENSOR_UNIT_PERMILLAGE     (7)  /* Relative Humidity       unit: permillage */
-#define  RT_SENSOR_UNIT_DCELSIUS       (8)  /* Temperature             unit: dCelsius   */
-#define  RT_SENSOR_UNIT_HZ             (9)  /* Frequency               unit: HZ         */
-#define  RT_SENSOR_UNIT_ONE            (10) /* Dimensionless quantity  unit: 1          */
-#define  RT_SENSOR_UNIT_BPM            (11) /* Heart rate              unit: bpm        */
-#define  RT_SENSOR_UNIT_MM             (12) /* Distance                unit: mm         */
-#define  RT_SENSOR_UNIT_MN             (13) /* Force                   unit: mN         */
-//add
-#define  RT_SENSOR_UNIT_PPM            (14) /* Force                   unit: mN         */
-#define  RT_SENSOR_UNIT_PPB            (15) /* Force                   unit: mN         */
-  
-
-
-/* Sensor communication interface types */
-
-#define  RT_SENSOR_INTF_I2C            (1 << 0)
-#define  RT_SENSOR_INTF_SPI            (1 << 1)
-#define  RT_SENSOR_INTF_UART           (1 << 2)
-#define  RT_SENSOR_INTF_ONEWIRE        (1 << 3)
-
-/* Sensor power mode types */
-
-#define  RT_SENSOR_POWER_NONE          (0)
-#define  RT_SENSOR_POWER_DOWN          (1)  /* power down mode   */
-#define  RT_SENSOR_POWER_NORMAL        (2)  /* normal-power mode */
-#define  RT_SENSOR_POWER_LOW           (3)  /* low-power mode    */
-#define  RT_SENSOR_POWER_HIGH          (4)  /* high-power mode   */
-
-/* Sensor work mode types */
-
-#define  RT_SENSOR_MODE_NONE           (0)
-#define  RT_SENSOR_MODE_POLLING        (1)  /* One shot only read a data */
-#define  RT_SENSOR_MODE_INT            (2)  /* TODO: One shot interrupt only read a data */
-#define  RT_SENSOR_MODE_FIFO           (3)  /* TODO: One shot interrupt read all fifo data */
-
-/* Sensor control cmd types */
-
-#define  RT_SENSOR_CTRL_GET_ID         (0)  /* Get device id */
-#define  RT_SENSOR_CTRL_GET_INFO       (1)  /* Get sensor info */
-#define  RT_SENSOR_CTRL_SET_RANGE      (2)  /* Set the measure range of sensor. unit is info of sensor */
-#define  RT_SENSOR_CTRL_SET_ODR        (3)  /* Set output date rate. unit is HZ */
-#define  RT_SENSOR_CTRL_SET_MODE       (4)  /* Set sensor's work mode. ex. RT_SENSOR_MODE_POLLING,RT_SENSOR_MODE_INT */
-#define  RT_SENSOR_CTRL_SET_POWER      (5)  /* Set power mode. args type of sensor power mode. ex. RT_SENSOR_POWER_DOWN,RT_SENSOR_POWER_NORMAL */
-#define  RT_SENSOR_CTRL_SELF_TEST      (6)  /* Take a self test */
-
-struct rt_sensor_info
-{
-    rt_uint8_t     type;                    /* The sensor type */
-    rt_uint8_t     vendor;                  /* Vendor of sensors */
-    const char    *model;                   /* model name of sensor */
-    rt_uint8_t     unit;                    /* unit of measurement */
-    rt_uint8_t     intf_type;               /* Communication interface type */
-    rt_int32_t     range_max;               /* maximum range of this sensor's value. unit is 'unit' */
-    rt_int32_t     range_min;               /* minimum range of this sensor's value. unit is 'unit' */
-    rt_uint32_t    period_min;              /* Minimum measurement period,unit:ms. zero = not a constant rate */
-    rt_uint8_t     fifo_max;
-};
-
-struct rt_sensor_intf
-{
-    char                       *dev_name;   /* The name of the communication device */
-    rt_uint8_t                  type;       /* Communication interface type */
-    void                       *user_data;  /* Private data for the sensor. ex. i2c addr,spi cs,control I/O */
-};
-
-struct rt_sensor_config
-{
-    struct rt_sensor_intf        intf;      /* sensor interface config */
-    struct rt_device_pin_mode    irq_pin;   /* Interrupt pin, The purpose of this pin is to notification read data */
-    rt_uint8_t                   mode;      /* sensor work mode */
-    rt_uint8_t                   power;     /* sensor power mode */
-    rt_uint16_t                  odr;       /* sensor out data rate */
-    rt_int32_t                   range;     /* sensor range of measurement */
-};
-
-typedef struct rt_sensor_device *rt_sensor_t;
-
-struct rt_sensor_device
-{
-    struct rt_device             parent;    /* The standard device */
-
-    struct rt_sensor_info        info;      /* The sensor info data */
-    struct rt_sensor_config      config;    /* The sensor config data */
-
-    void                        *data_buf;  /* The buf of the data received */
-    rt_size_t                    data_len;  /* The size of the data received */
-
-    const struct rt_sensor_ops  *ops;       /* The sensor ops */
-
-    struct rt_sensor_module     *module;    /* The sensor module */
-    
-    rt_err_t (*irq_handle)(rt_sensor_t sensor);             /* Called when an interrupt is generated, registered by the driver */
-};
-
-struct rt_sensor_module
-{
-    rt_mutex_t                   lock;                      /* The module lock */
-
-    rt_sensor_t                  sen[RT_SENSOR_MODULE_MAX]; /* The module contains a list of sensors */
-    rt_uint8_t                   sen_num;                   /* Number of sensors contained in the module */
-};
-
-/* 3-axis Data Type */
-struct sensor_3_axis
-{
-    rt_int32_t x;
-    rt_int32_t y;
-    rt_int32_t z;
-};
-
-struct rt_sensor_data
-{
-    rt_uint32_t         timestamp;          /* The timestamp when the data was received */
-    rt_uint8_t          type;               /* The sensor type of the data */
-    union
-    {
-        struct sensor_3_axis acce;          /* Accelerometer.       unit: mG          */
-        struct sensor_3_axis gyro;          /* Gyroscope.           unit: mdps        */
-        struct sensor_3_axis mag;           /* Magnetometer.        unit: mGauss      */
-        rt_int32_t           temp;          /* Temperature.         unit: dCelsius    */
-        rt_int32_t           humi;          /* Relative humidity.   unit: permillage  */
-        rt_int32_t           baro;          /* Pressure.            unit: pascal (Pa) */
-        rt_int32_t           light;         /* Light.               unit: lux         */
-        rt_int32_t           proximity;     /* Distance.            unit: centimeters */
-        rt_int32_t           hr;            /* Heart rate.          unit: bpm         */
-        rt_int32_t           tvoc;          /* TVOC.                unit: permillage  */
-        rt_int32_t           noise;         /* Noise Loudness.      unit: HZ          */
-        rt_uint32_t          step;          /* Step sensor.         unit: 1           */
-        rt_int32_t           force;         /* Force sensor.        unit: mN          */
-        //add
-        rt_int32_t           eco2;          /* CO2.                 unit: permillage  */
-
-    } data;
-};
-
-struct rt_sensor_ops
-{
-    rt_size_t (*fetch_data)(struct rt_sensor_device *sensor, void *buf, rt_size_t len);
-    rt_err_t (*control)(struct rt_sensor_device *sensor, int cmd, void *arg);
-};
-
-int rt_hw_sensor_register(rt_sensor_t sensor,
-                          const char              *name,
-                          rt_uint32_t              flag,
-                          void                    *data);
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* __SENSOR_H__ */
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-01-31     flybreak     first version
+ */
+
+#ifndef __SENSOR_H__
+#define __SENSOR_H__
+
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef RT_USING_RTC
+#define  rt_sensor_get_ts()  time(RT_NULL)   /* API for the sensor to get the timestamp */
+#else
+#define  rt_sensor_get_ts()  rt_tick_get()   /* API for the sensor to get the timestamp */
+#endif
+
+/*
+ * rt_sensor_get_ts() is kept for the 32-bit 'timestamp' field of existing drivers.
+ * New code should use rt_sensor_get_ts_us(), which fills 'timestamp_us'. The framework
+ * stamps 'timestamp_us' itself for drivers that leave it at zero. Unless the BSP registers
+ * a faster counter with rt_sensor_clock_register(), it has the resolution of the OS tick,
+ * see rt_sensor_get_ts_res_us().
+ */
+
+#define  RT_PIN_NONE                   0xFFFF    /* RT PIN NONE */
+#define  RT_DEVICE_FLAG_FIFO_RX        0x200     /* Flag to use when the sensor is open by fifo mode */
+
+#define  RT_SENSOR_MODULE_MAX          (3)       /* The maximum number of members of a sensor module */
+
+/* Sensor types */
+
+#define RT_SENSOR_CLASS_NONE           (0)
+#define RT_SENSOR_CLASS_ACCE           (1)  /* Accelerometer     */
+#define RT_SENSOR_CLASS_GYRO           (2)  /* Gyroscope         */
+#define RT_SENSOR_CLASS_MAG            (3)  /* Magnetometer      */
+#define RT_SENSOR_CLASS_TEMP           (4)  /* Temperature       */
+#define RT_SENSOR_CLASS_HUMI           (5)  /* Relative Humidity */
+#define RT_SENSOR_CLASS_BARO           (6)  /* Barometer         */
+#define RT_SENSOR_CLASS_LIGHT          (7)  /* Ambient light     */
+#define RT_SENSOR_CLASS_PROXIMITY      (8)  /* Proximity         */
+#define RT_SENSOR_CLASS_HR             (9)  /* Heart Rate        */
+#define RT_SENSOR_CLASS_TVOC           (10) /* TVOC Level        */
+#define RT_SENSOR_CLASS_NOISE          (11) /* Noise Loudness    */
+#define RT_SENSOR_CLASS_STEP           (12) /* Step sensor       */
+#define RT_SENSOR_CLASS_FORCE          (13) /* Force sensor      */
+//add
+#define RT_SENSOR_CLASS_ECO2           (14) /* CO2 Level        */    
+
+#define RT_SENSOR_CLASS_MAX            (15) /* Number of sensor types */
+
+/* Sensor vendor types */
+
+#define RT_SENSOR_VENDOR_UNKNOWN       (0)
+#define RT_SENSOR_VENDOR_STM           (1)  /* STMicroelectronics */
+#define RT_SENSOR_VENDOR_BOSCH         (2)  /* Bosch */
+#define RT_SENSOR_VENDOR_INVENSENSE    (3)  /* Invensense */
+#define RT_SENSOR_VENDOR_SEMTECH       (4)  /* Semtech */
+#define RT_SENSOR_VENDOR_GOERTEK       (5)  /* Goertek */
+#define RT_SENSOR_VENDOR_MIRAMEMS      (6)  /* MiraMEMS */
+#define RT_SENSOR_VENDOR_DALLAS        (7)  /* Dallas */
+//add
+#define RT_SENSOR_VENDOR_AMS        (8)  /* Dallas */
+
+/* Sensor unit types */
+
+#define  RT_SENSOR_UNIT_NONE           (0)
+#define  RT_SENSOR_UNIT_MG             (1)  /* Accelerometer           unit: mG         */
+#define  RT_SENSOR_UNIT_MDPS           (2)  /* Gyroscope               unit: mdps       */
+#define  RT_SENSOR_UNIT_MGAUSS         (3)  /* Magnetometer            unit: mGauss     */
+#define  RT_SENSOR_UNIT_LUX            (4)  /* Ambient light           unit: lux        */
+#define  RT_SENSOR_UNIT_CM             (5)  /* Distance                unit: cm         */
+#define  RT_SENSOR_UNIT_PA             (6)  /* Barometer               unit: pa         */
+#define  RT_SENSOR_UNIT_PERMILLAGE     (7)  /* Relative Humidity       unit: permillage */
+#define  RT_SENSOR_UNIT_DCELSIUS       (8)  /* Temperature             unit: dCelsius   */
+#define  RT_SENSOR_UNIT_HZ             (9)  /* Frequency               unit: HZ         */
+#define  RT_SENSOR_UNIT_ONE            (10) /* Dimensionless quantity  unit: 1          */
+#define  RT_SENSOR_UNIT_BPM            (11) /* Heart rate              unit: bpm        */
+#define  RT_SENSOR_UNIT_MM             (12) /* Distance                unit: mm         */
+#define  RT_SENSOR_UNIT_MN             (13) /* Force                   unit: mN         */
+//add
+#define  RT_SENSOR_UNIT_PPM            (14) /* Force                   unit: mN         */
+#define  RT_SENSOR_UNIT_PPB            (15) /* Force                   unit: mN         */
+  
+
+
+/* Sensor communication interface types */
+
+#define  RT_SENSOR_INTF_I2C            (1 << 0)
+#define  RT_SENSOR_INTF_SPI            (1 << 1)
+#define  RT_SENSOR_INTF_UART           (1 << 2)
+#define  RT_SENSOR_INTF_ONEWIRE        (1 << 3)
+
+/* Sensor power mode types */
+
+#define  RT_SENSOR_POWER_NONE          (0)
+#define  RT_SENSOR_POWER_DOWN          (1)  /* power down mode   */
+#define  RT_SENSOR_POWER_NORMAL        (2)  /* normal-power mode */
+#define  RT_SENSOR_POWER_LOW           (3)  /* low-power mode    */
+#define  RT_SENSOR_POWER_HIGH          (4)  /* high-power mode   */
+
+/* Sensor work mode types */
+
+#define  RT_SENSOR_MODE_NONE           (0)
+#define  RT_SENSOR_MODE_POLLING        (1)  /* One shot only read a data */
+#define  RT_SENSOR_MODE_INT            (2)  /* TODO: One shot interrupt only read a data */
+#define  RT_SENSOR_MODE_FIFO           (3)  /* TODO: One shot interrupt read all fifo data */
+
+/* Sensor control cmd types */
+
+#define  RT_SENSOR_CTRL_GET_ID         (0)  /* Get device id */
+#define  RT_SENSOR_CTRL_GET_INFO       (1)  /* Get sensor info */
+#define  RT_SENSOR_CTRL_SET_RANGE      (2)  /* Set the measure range of sensor. unit is info of sensor */
+#define  RT_SENSOR_CTRL_SET_ODR        (3)  /* Set output date rate. unit is HZ */
+#define  RT_SENSOR_CTRL_SET_MODE       (4)  /* Set sensor's work mode. ex. RT_SENSOR_MODE_POLLING,RT_SENSOR_MODE_INT */
+#define  RT_SENSOR_CTRL_SET_POWER      (5)  /* Set power mode. args type of sensor power mode. ex. RT_SENSOR_POWER_DOWN,RT_SENSOR_POWER_NORMAL */
+#define  RT_SENSOR_CTRL_SELF_TEST      (6)  /* Take a self test */
+#define  RT_SENSOR_CTRL_SET_MAX_AGE    (7)  /* Let a read return the cached sample if it is not older than var. unit is ms, 0 = off */
+#define  RT_SENSOR_CTRL_SET_IDLE_TIMEOUT (8) /* Power an open polled sensor down after var ms without a fetch, the next read wakes it. 0 = off */
+#define  RT_SENSOR_CTRL_SET_REPLAY_SPEED (9) /* Replay sensors only: play the log var times faster than recorded, 0 = one record per fetch */
+
+struct rt_sensor_info
+{
+    rt_uint8_t     type;                    /* The sensor type */
+    rt_uint8_t     vendor;                  /* Vendor of sensors */
+    const char    *model;                   /* model name of sensor */
+    rt_uint8_t     unit;                    /* unit of measurement */
+    rt_uint8_t     intf_type;               /* Communication interface type */
+    rt_int32_t     range_max;               /* maximum range of this sensor's value. unit is 'unit' */
+    rt_int32_t     range_min;               /* minimum range of this sensor's value. unit is 'unit' */
+    rt_uint32_t    period_min;              /* Minimum measurement period,unit:ms. zero = not a constant rate */
+    rt_uint8_t     fifo_max;
+};
+
+struct rt_sensor_intf
+{
+    char                       *dev_name;   /* The name of the communication device */
+    rt_uint8_t                  type;       /* Communication interface type */
+    void                       *user_data;  /* Private data for the sensor. ex. i2c addr,spi cs,control I/O */
+};
+
+struct rt_sensor_config
+{
+    struct rt_sensor_intf        intf;      /* sensor interface config */
+    struct rt_device_pin_mode    irq_pin;   /* Interrupt pin, The purpose of this pin is to notification read data */
+    rt_uint8_t                   mode;      /* sensor work mode */
+    rt_uint8_t                   power;     /* sensor power mode */
+    rt_uint16_t                  odr;       /* sensor out data rate */
+    rt_int32_t                   range;     /* sensor range of measurement */
+    rt_uint32_t                  max_age;   /* Age of a cached sample a read accepts, unit: ms. 0 = always fetch */
+    rt_uint32_t                  idle_timeout; /* Time without a fetch before powering down, unit: ms. 0 = never */
+};
+
+typedef struct rt_sensor_device *rt_sensor_t;
+
+/* 3-axis Data Type */
+struct sensor_3_axis
+{
+    rt_int32_t x;
+    rt_int32_t y;
+    rt_int32_t z;
+};
+
+/* Sensor data flags */
+
+#define  RT_SENSOR_DATA_FLAG_EVENT     (1 << 0)  /* Reported by an event of the sensor (e.g. a threshold crossing), not by a sample period */
+
+struct rt_sensor_data
+{
+    rt_uint32_t         timestamp;          /* The timestamp when the data was received */
+    rt_uint8_t          type;               /* The sensor type of the data */
+    rt_uint8_t          flags;              /* RT_SENSOR_DATA_FLAG_xxx */
+    union
+    {
+        struct sensor_3_axis acce;          /* Accelerometer.       unit: mG          */
+        struct sensor_3_axis gyro;          /* Gyroscope.           unit: mdps        */
+        struct sensor_3_axis mag;           /* Magnetometer.        unit: mGauss      */
+        rt_int32_t           temp;          /* Temperature.         unit: dCelsius    */
+        rt_int32_t           humi;          /* Relative humidity.   unit: permillage  */
+        rt_int32_t           baro;          /* Pressure.            unit: pascal (Pa) */
+        rt_int32_t           light;         /* Light.               unit: lux         */
+        rt_int32_t           proximity;     /* Distance.            unit: centimeters */
+        rt_int32_t           hr;            /* Heart rate.          unit: bpm         */
+        rt_int32_t           tvoc;          /* TVOC.                unit: permillage  */
+        rt_int32_t           noise;         /* Noise Loudness.      unit: HZ          */
+        rt_uint32_t          step;          /* Step sensor.         unit: 1           */
+        rt_int32_t           force;         /* Force sensor.        unit: mN          */
+        //add
+        rt_int32_t           eco2;          /* CO2.                 unit: permillage  */
+
+    } data;
+    rt_uint64_t         timestamp_us;       /* Monotonic timestamp of the data, unit: us, never wraps */
+};
+
+/*
+ * Fifo slot of a scalar sample. The union is cut to its one 32-bit value
+ * and timestamp_us to 48 bits (8.9 years of uptime), so a slot takes 16
+ * bytes instead of the 32 of a struct rt_sensor_data and a ring of the
+ * same size holds twice the samples.
+ */
+struct rt_sensor_fifo_sample
+{
+    rt_uint32_t         timestamp;          /* The legacy timestamp of the sample */
+    rt_uint32_t         timestamp_us_lo;    /* Bits 0-31 of timestamp_us */
+    rt_uint16_t         timestamp_us_hi;    /* Bits 32-47 of timestamp_us */
+    rt_uint8_t          type;               /* The sensor type of the value */
+    rt_uint8_t          flags;              /* RT_SENSOR_DATA_FLAG_xxx */
+    rt_int32_t          value;              /* The scalar member of the data union */
+};
+
+/*
+ * Single-producer/single-consumer ring of samples. The producer (ISR or
+ * driver) only moves 'in', the reader only moves 'out', so neither side
+ * needs the sensor lock. 'in' and 'out' are free running counters, the
+ * ring size is a power of 2 and 'in - out' is the number of samples held.
+ * While the sensor has subscribers 'out' trails the slowest of them.
+ * The ring of a scalar sensor holds packed struct rt_sensor_fifo_sample
+ * slots, which readers unpack; rt_sensor_peek() unpacks them one at a
+ * time into 'peek'. 3-axis sensors keep full struct rt_sensor_data slots.
+ */
+struct rt_sensor_fifo
+{
+    void                        *buf;       /* The ring storage */
+    rt_uint32_t                  mask;      /* The ring size minus one */
+    volatile rt_uint32_t         in;        /* Write counter, only moved by the producer */
+    volatile rt_uint32_t         out;       /* Read counter, only moved by the consumer side */
+    rt_uint32_t                  overflow;  /* Number of samples dropped because the ring was full */
+    rt_bool_t                    packed;    /* The slots are struct rt_sensor_fifo_sample */
+    struct rt_sensor_data        peek;      /* The slot rt_sensor_peek() unpacked from a packed ring */
+};
+
+/*
+ * Performance counters of a sensor, kept with RT_SENSOR_USING_STATS. They
+ * are updated without a lock, a reader may see a sample mid-update. Fetch
+ * times come from rt_sensor_get_ts_us(); on the tick clock a fetch shorter
+ * than a tick counts as 0 us.
+ */
+#define  RT_SENSOR_STATS_HIST_BINS     20        /* Bin i counts fetches of [2^i, 2^(i+1)) us, the last one the rest */
+
+struct rt_sensor_stats
+{
+    rt_uint32_t                  reads;         /* Calls of rt_device_read() */
+    rt_uint32_t                  cache_hits;    /* Reads served by the last sample, see RT_SENSOR_CTRL_SET_MAX_AGE */
+    rt_uint32_t                  fetches;       /* Calls of ops->fetch_data or ops->fetch_module */
+    rt_uint32_t                  fetch_fails;   /* Fetches that returned no data */
+    rt_uint32_t                  bus_errors;    /* Failed bus transfers, counted by the driver */
+    rt_uint32_t                  range_drops;   /* Samples dropped as out of range, counted by the driver */
+    rt_uint32_t                  fetch_us_max;  /* Longest fetch, unit: us */
+    rt_uint64_t                  fetch_us_sum;  /* Time spent in fetches, unit: us */
+    rt_uint32_t                  hist[RT_SENSOR_STATS_HIST_BINS]; /* log2 histogram of the fetch time */
+};
+
+#ifdef RT_SENSOR_USING_STATS
+#define  RT_SENSOR_STATS_INC(sensor, counter)  ((sensor)->stats.counter++)
+#else
+#define  RT_SENSOR_STATS_INC(sensor, counter)
+#endif
+
+/*
+ * Events of the trace ring, kept with RT_SENSOR_USING_TRACE. A _BEGIN/_END
+ * pair brackets a span on the thread that recorded it.
+ */
+#define  RT_SENSOR_TRACE_NONE          0
+#define  RT_SENSOR_TRACE_OPEN          1         /* rt_sensor_open(), arg: oflag */
+#define  RT_SENSOR_TRACE_CLOSE         2         /* rt_sensor_close() */
+#define  RT_SENSOR_TRACE_READ_BEGIN    3         /* rt_sensor_read() entered, arg: len */
+#define  RT_SENSOR_TRACE_READ_END      4         /* rt_sensor_read() returns, arg: samples read */
+#define  RT_SENSOR_TRACE_FETCH_BEGIN   5         /* Driver fetch started */
+#define  RT_SENSOR_TRACE_FETCH_END     6         /* Driver fetch done, arg: samples fetched */
+#define  RT_SENSOR_TRACE_IRQ           7         /* Data-ready ISR entered */
+#define  RT_SENSOR_TRACE_RX_INDICATE   8         /* rx_indicate called, arg: len */
+#define  RT_SENSOR_TRACE_LOCK_BEGIN    9         /* Waiting for the sensor lock */
+#define  RT_SENSOR_TRACE_LOCK_END      10        /* Sensor lock taken */
+#define  RT_SENSOR_TRACE_MAX           11
+
+#ifdef RT_SENSOR_USING_TRACE
+#define  RT_SENSOR_TRACE(event, sensor, arg)   rt_sensor_trace(event, sensor, arg)
+#else
+#define  RT_SENSOR_TRACE(event, sensor, arg)
+#endif
+
+struct rt_sensor_device
+{
+    struct rt_device             parent;    /* The standard device */
+
+    struct rt_sensor_info        info;      /* The sensor info data */
+    struct rt_sensor_config      config;    /* The sensor config data */
+
+    struct rt_sensor_fifo        fifo;      /* The ring of the data received, sized from info.fifo_max */
+
+    const struct rt_sensor_ops  *ops;       /* The sensor ops */
+
+    struct rt_sensor_module     *module;    /* The sensor module */
+    rt_uint32_t                  module_gen;    /* Module generation whose sample this member has consumed */
+    rt_mutex_t                   lock;          /* Serializes the driver calls of a sensor outside a module */
+
+    rt_list_t                    sched_node;    /* Node in the timer wheel of the sampling scheduler */
+    rt_tick_t                    sched_period;  /* Sampling period in ticks, 0 if not scheduled */
+    rt_tick_t                    sched_expire;  /* Tick of the next scheduled sample */
+
+    rt_list_t                    pm_node;       /* Node in the idle power management list */
+    rt_tick_t                    access_tick;   /* Tick of the last fetch, for the idle timeout */
+
+    rt_list_t                    sub_list;      /* Subscribers sharing the fifo, see rt_sensor_subscribe() */
+
+    rt_list_t                    class_node;    /* Node in the registry list of its sensor type */
+
+    rt_list_t                    irq_node;      /* Node in the pending list of the interrupt worker */
+    volatile rt_uint8_t          irq_pending;   /* Set by the ISR, cleared when the worker dispatches it */
+    rt_uint64_t                  irq_ts_us;     /* Time of the latest data-ready interrupt, 0 once a fetch used it */
+
+    struct rt_sensor_data        last;          /* The latest sample, guarded by last_seq */
+    volatile rt_uint32_t         last_seq;      /* Seqlock of 'last', odd while it is written, 0 if never written */
+
+#ifdef RT_SENSOR_USING_STATS
+    struct rt_sensor_stats       stats;         /* Performance counters */
+#endif
+
+    rt_err_t (*irq_handle)(rt_sensor_t sensor);             /* Called when an interrupt is generated, registered by the driver */
+};
+
+struct rt_sensor_module
+{
+    rt_mutex_t                   lock;                      /* The module lock */
+
+    rt_sensor_t                  sen[RT_SENSOR_MODULE_MAX]; /* The module contains a list of sensors */
+    rt_uint8_t                   sen_num;                   /* Number of sensors contained in the module */
+
+    rt_uint32_t                  generation;                /* Bumped by every module-wide fetch */
+    rt_tick_t                    fetch_tick;                /* Tick of the last module-wide fetch */
+    rt_uint32_t                  window;                    /* Age until which a fetch is handed to the partners, unit: ms. 0 = period_min of the reader */
+};
+
+/* Samples of every member of a module taken by one fetch */
+struct rt_sensor_module_snapshot
+{
+    rt_uint32_t           generation;                  /* The module generation the samples belong to */
+    rt_uint8_t            num;                         /* Number of members, data[i] belongs to sen[i] */
+    struct rt_sensor_data data[RT_SENSOR_MODULE_MAX];  /* type is RT_SENSOR_CLASS_NONE if a member failed */
+};
+
+/*
+ * Compact record of one scalar sample for history storage, used by the
+ * record and replay logs; the sensor fifo has slots of its own, which
+ * readers at different positions can unpack on their own. The time is
+ * a delta to the previous record of the same stream, so a record takes 8
+ * bytes (6 with RT_SENSOR_SAMPLE_USING_INT16) instead of a full struct
+ * rt_sensor_data. 3-axis sensor types do not fit in it.
+ */
+#ifdef RT_SENSOR_SAMPLE_USING_INT16
+typedef rt_int16_t rt_sensor_sample_value_t;
+#define  RT_SENSOR_SAMPLE_VALUE_MAX    (32767)
+#define  RT_SENSOR_SAMPLE_VALUE_MIN    (-32768)
+#else
+typedef rt_int32_t rt_sensor_sample_value_t;
+#endif
+
+#define  RT_SENSOR_SAMPLE_FLAG_GAP     (1 << 0)  /* The time since the previous record was cut to the delta maximum */
+#define  RT_SENSOR_SAMPLE_FLAG_CLIPPED (1 << 1)  /* The value did not fit and was saturated */
+#define  RT_SENSOR_SAMPLE_FLAG_EVENT   (1 << 2)  /* The sample had RT_SENSOR_DATA_FLAG_EVENT set */
+
+struct rt_sensor_sample
+{
+    rt_uint16_t                delta;      /* Time since the previous record of the stream, unit: ms */
+    rt_uint8_t                 channel;    /* The sensor type of the value */
+    rt_uint8_t                 flags;      /* RT_SENSOR_SAMPLE_FLAG_xxx */
+    rt_sensor_sample_value_t   value;      /* The value in the unit of the sensor type */
+};
+
+/* Time base of a stream of records, the writer and the reader each keep one */
+struct rt_sensor_sample_stream
+{
+    rt_uint64_t                base_us;    /* Timestamp the next delta counts from */
+};
+
+/*
+ * Log of the samples returned by rt_device_read(), kept with
+ * RT_SENSOR_USING_RECORD: a header, then the struct rt_sensor_sample
+ * records of all sensors as one stream, in the byte order of the writer.
+ * The channel of a record tells the sensor by its type, so a log holds
+ * one sensor per type.
+ */
+#define  RT_SENSOR_RECORD_MAGIC        (0x31525352)  /* "RSR1" */
+
+struct rt_sensor_record_header
+{
+    rt_uint32_t                magic;       /* RT_SENSOR_RECORD_MAGIC */
+    rt_uint8_t                 sample_size; /* sizeof(struct rt_sensor_sample) of the writer */
+    rt_uint8_t                 reserved[3];
+    rt_uint64_t                base_us;     /* Timestamp the delta of the first record counts from */
+};
+
+/* Sink and source of a log, both return the number of bytes moved */
+typedef rt_size_t (*rt_sensor_record_write_t)(const void *buf, rt_size_t size, void *user_data);
+typedef rt_size_t (*rt_sensor_record_read_t)(void *buf, rt_size_t size, void *user_data);
+
+#ifdef RT_SENSOR_USING_RECORD
+#define  RT_SENSOR_RECORD(sensor, data, num)   rt_sensor_record(sensor, data, num)
+#else
+#define  RT_SENSOR_RECORD(sensor, data, num)
+#endif
+
+/*
+ * A consumer of the sensor fifo with a read cursor of its own. Each
+ * subscriber sees every 'decimation'-th sample published by the sensor
+ * without an extra bus read; a sample is released to the producer once
+ * the slowest subscriber has passed it.
+ */
+struct rt_sensor_subscriber
+{
+    rt_list_t             list;         /* Node in the subscriber list of the sensor */
+    rt_sensor_t           sensor;       /* The sensor subscribed to */
+    rt_uint32_t           cursor;       /* Fifo counter of the next sample to look at */
+    rt_uint32_t           phase;        /* Fifo counter the decimation is counted from */
+    rt_uint16_t           decimation;   /* Deliver one sample out of every 'decimation' */
+
+    rt_err_t (*notify)(struct rt_sensor_subscriber *sub, rt_size_t size);  /* Samples are ready, from a thread with interrupts on unless a driver notifies in its ISR */
+    void                 *user_data;    /* Private data of the subscriber */
+};
+
+/*
+ * Blink or beep pattern of an alarm output: 'on_ms' active, 'off_ms'
+ * inactive, 'count' times. on_ms = 0 is off, off_ms = 0 steady on and
+ * count = 0 repeats until the next rt_sensor_alarm_set().
+ */
+struct rt_sensor_alarm_pattern
+{
+    rt_uint16_t           on_ms;
+    rt_uint16_t           off_ms;
+    rt_uint16_t           count;
+};
+
+/* A buzzer or LED on a pin, stepped by a timer so a sensor read never waits for it */
+struct rt_sensor_alarm
+{
+    rt_base_t             pin;
+    rt_uint8_t            active_level; /* PIN_LOW or PIN_HIGH */
+    rt_bool_t             on;           /* The output is active */
+    rt_uint16_t           left;         /* Active phases left, 0 = no limit */
+    struct rt_sensor_alarm_pattern pattern;
+    rt_timer_t            timer;
+};
+typedef struct rt_sensor_alarm *rt_sensor_alarm_t;
+
+struct rt_sensor_ops
+{
+    rt_size_t (*fetch_data)(struct rt_sensor_device *sensor, void *buf, rt_size_t len);
+    rt_err_t (*control)(struct rt_sensor_device *sensor, int cmd, void *arg);
+    /* Optional. Read all members of the module in one bus transaction, buf[i] belongs to sen[i] */
+    rt_size_t (*fetch_module)(struct rt_sensor_module *module, struct rt_sensor_data *buf);
+};
+
+int rt_hw_sensor_register(rt_sensor_t sensor,
+                          const char              *name,
+                          rt_uint32_t              flag,
+                          void                    *data);
+
+/* Registry of the sensors by type, lookups need no device name */
+rt_sensor_t rt_sensor_first(rt_uint8_t type);
+rt_sensor_t rt_sensor_next(rt_sensor_t sensor);
+rt_sensor_t rt_sensor_find(rt_uint8_t type, rt_uint8_t vendor, const char *model);
+rt_size_t   rt_sensor_count(rt_uint8_t type);
+
+#define rt_sensor_foreach(sensor, type) \
+    for ((sensor) = rt_sensor_first(type); (sensor) != RT_NULL; (sensor) = rt_sensor_next(sensor))
+
+rt_uint64_t rt_sensor_get_ts_us(void);
+rt_uint32_t rt_sensor_get_ts_res_us(void);
+rt_err_t    rt_sensor_clock_register(rt_uint32_t (*read)(void), rt_uint32_t freq);
+
+rt_size_t rt_sensor_module_read(struct rt_sensor_module *module, struct rt_sensor_module_snapshot *snap);
+
+void     rt_sensor_sample_stream_init(struct rt_sensor_sample_stream *stream, rt_uint64_t base_us);
+rt_err_t rt_sensor_sample_pack(struct rt_sensor_sample_stream *stream, const struct rt_sensor_data *data,
+                               struct rt_sensor_sample *sample);
+void     rt_sensor_sample_unpack(struct rt_sensor_sample_stream *stream, const struct rt_sensor_sample *sample,
+                                 struct rt_sensor_data *data);
+
+/* Latest sample without a lock or a bus access */
+rt_err_t rt_sensor_get_last(rt_sensor_t sensor, struct rt_sensor_data *data);
+
+rt_err_t rt_sensor_sched_start(rt_sensor_t sensor);
+rt_err_t rt_sensor_sched_stop(rt_sensor_t sensor);
+
+rt_size_t rt_sensor_fifo_push(rt_sensor_t sensor, const struct rt_sensor_data *data, rt_size_t num);
+rt_size_t rt_sensor_fifo_len(rt_sensor_t sensor);
+
+/* Fan-out of the fifo to several consumers, the device must be open to produce samples */
+rt_err_t  rt_sensor_subscribe(rt_sensor_t sensor, struct rt_sensor_subscriber *sub, rt_uint16_t decimation,
+                              rt_err_t (*notify)(struct rt_sensor_subscriber *sub, rt_size_t size), void *user_data);
+rt_err_t  rt_sensor_unsubscribe(struct rt_sensor_subscriber *sub);
+rt_size_t rt_sensor_subscriber_read(struct rt_sensor_subscriber *sub, struct rt_sensor_data *buf, rt_size_t len);
+
+/* Trace ring, dumped as text for sensors/tools/sensor_trace2json.py */
+void rt_sensor_trace(rt_uint8_t event, rt_sensor_t sensor, rt_uint32_t arg);
+void rt_sensor_trace_dump(void);
+void rt_sensor_trace_clear(void);
+
+/* Recording of the samples read and their replay by a pseudo sensor */
+rt_err_t rt_sensor_record_start(rt_sensor_record_write_t write, void *user_data);
+rt_err_t rt_sensor_record_stop(void);
+void     rt_sensor_record(rt_sensor_t sensor, const struct rt_sensor_data *data, rt_size_t num);
+int      rt_hw_sensor_replay_init(const char *name, rt_uint8_t type, rt_sensor_record_read_t read, void *user_data,
+                                  rt_uint16_t speed);
+
+/* Alarm outputs, rt_sensor_alarm_set() may be called from an ISR */
+rt_err_t rt_sensor_alarm_init(rt_sensor_alarm_t alarm, const char *name, rt_base_t pin, rt_uint8_t active_level);
+rt_err_t rt_sensor_alarm_detach(rt_sensor_alarm_t alarm);
+void     rt_sensor_alarm_set(rt_sensor_alarm_t alarm, const struct rt_sensor_alarm_pattern *pattern);
+
+/* Zero-copy access to buffered samples, for the single reader of a device without subscribers */
+rt_size_t rt_sensor_peek(rt_sensor_t sensor, struct rt_sensor_data **data);
+void      rt_sensor_commit(rt_sensor_t sensor, rt_size_t num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_H__ */
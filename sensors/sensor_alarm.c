@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include "sensor.h"
+#include <rthw.h>
+
+#define DBG_TAG  "sensor.alarm"
+#define DBG_LVL  DBG_INFO
+#include <rtdbg.h>
+
+/* Sensor alarm correlation function */
+
+/*
+ * Every alarm owns a one-shot timer that is re-armed at each edge of the
+ * pattern, so a steady or idle output costs nothing. The state is only
+ * changed with interrupts off, from the setter or from the timer.
+ */
+static void sensor_alarm_write(rt_sensor_alarm_t alarm, rt_bool_t on)
+{
+    alarm->on = on;
+    rt_pin_write(alarm->pin, on ? alarm->active_level : !alarm->active_level);
+}
+
+static void sensor_alarm_arm(rt_sensor_alarm_t alarm, rt_uint16_t ms)
+{
+    rt_tick_t tick = rt_tick_from_millisecond(ms);
+
+    if (tick == 0)
+    {
+        tick = 1;
+    }
+    rt_timer_control(alarm->timer, RT_TIMER_CTRL_SET_TIME, &tick);
+    rt_timer_start(alarm->timer);
+}
+
+static void sensor_alarm_timeout(void *parameter)
+{
+    rt_sensor_alarm_t alarm = (rt_sensor_alarm_t)parameter;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (alarm->on)
+    {
+        sensor_alarm_write(alarm, RT_FALSE);
+        /* The last phase of a counted pattern ends inactive */
+        if (alarm->left == 0 || --alarm->left > 0)
+        {
+            sensor_alarm_arm(alarm, alarm->pattern.off_ms);
+        }
+    }
+    else
+    {
+        sensor_alarm_write(alarm, RT_TRUE);
+        sensor_alarm_arm(alarm, alarm->pattern.on_ms);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function initializes an alarm output, the pin is set to output and inactive.
+ *
+ * @param alarm the alarm to initialize
+ * @param name the name of its timer
+ * @param pin the pin of the buzzer or LED
+ * @param active_level the level that turns it on, PIN_LOW or PIN_HIGH
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t rt_sensor_alarm_init(rt_sensor_alarm_t alarm, const char *name, rt_base_t pin, rt_uint8_t active_level)
+{
+    RT_ASSERT(alarm != RT_NULL);
+
+    rt_memset(alarm, 0, sizeof(struct rt_sensor_alarm));
+    alarm->pin = pin;
+    alarm->active_level = active_level;
+
+    /* The period is set on every start */
+    alarm->timer = rt_timer_create(name, sensor_alarm_timeout, alarm, 1, RT_TIMER_FLAG_ONE_SHOT);
+    if (alarm->timer == RT_NULL)
+    {
+        LOG_E("alarm %s: no memory for the timer", name);
+        return -RT_ENOMEM;
+    }
+
+    rt_pin_mode(pin, PIN_MODE_OUTPUT);
+    sensor_alarm_write(alarm, RT_FALSE);
+
+    return RT_EOK;
+}
+
+/**
+ * This function turns an alarm output off and releases its timer.
+ *
+ * @param alarm the alarm
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+rt_err_t rt_sensor_alarm_detach(rt_sensor_alarm_t alarm)
+{
+    RT_ASSERT(alarm != RT_NULL);
+
+    if (alarm->timer == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_sensor_alarm_set(alarm, RT_NULL);
+    rt_timer_delete(alarm->timer);
+    alarm->timer = RT_NULL;
+
+    return RT_EOK;
+}
+
+/**
+ * This function posts the state of an alarm output. Posting the pattern
+ * that is running already keeps its phase, so a driver may post its state
+ * on every read.
+ *
+ * @param alarm the alarm
+ * @param pattern the pattern to play, RT_NULL = off
+ */
+void rt_sensor_alarm_set(rt_sensor_alarm_t alarm, const struct rt_sensor_alarm_pattern *pattern)
+{
+    static const struct rt_sensor_alarm_pattern off = {0, 0, 0};
+    rt_base_t level;
+
+    RT_ASSERT(alarm != RT_NULL);
+
+    /* An alarm that failed to initialize stays silent */
+    if (alarm->timer == RT_NULL)
+    {
+        return;
+    }
+
+    if (pattern == RT_NULL)
+    {
+        pattern = &off;
+    }
+
+    level = rt_hw_interrupt_disable();
+    if (alarm->pattern.on_ms == pattern->on_ms && alarm->pattern.off_ms == pattern->off_ms &&
+        alarm->pattern.count == pattern->count && (pattern->count == 0 || alarm->left > 0))
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    rt_timer_stop(alarm->timer);
+    alarm->pattern = *pattern;
+    alarm->left = pattern->count;
+    if (pattern->on_ms == 0)
+    {
+        alarm->left = 0;
+        sensor_alarm_write(alarm, RT_FALSE);
+    }
+    else
+    {
+        sensor_alarm_write(alarm, RT_TRUE);
+        if (pattern->off_ms != 0)
+        {
+            sensor_alarm_arm(alarm, pattern->on_ms);
+        }
+    }
+    rt_hw_interrupt_enable(level);
+}
@@ -1,456 +1,1007 @@
-/*
- * Copyright (c) 2006-2018, RT-Thread Development Team
- *
- * SPDX-License-Identifier: Apache-2.0
- *
- * Change Logs:
- * Date           Author         Notes
- * 2019-01-31     flybreak       first version
- * 2019-07-16     WillianChan    Increase the output of sensor information
- */
-
-#include "sensor.h"
-
-#define DBG_TAG  "sensor.cmd"
-#define DBG_LVL DBG_INFO
-#include <rtdbg.h>
-
-#include <stdlib.h>
-//add header
-#include <stdint.h>
-#include <string.h>
-
-
-static rt_sem_t sensor_rx_sem = RT_NULL;
-
-static void sensor_show_data(rt_size_t num, rt_sensor_t sensor, struct rt_sensor_data *sensor_data)
-{
-    switch (sensor->info.type)
-    {
-    case RT_SENSOR_CLASS_ACCE:
-        LOG_I("num:%3d, x:%5d, y:%5d, z:%5d mg, timestamp:%5d", num, sensor_data->data.acce.x, sensor_data->data.acce.y, sensor_data->data.acce.z, sensor_data->timestamp);
-        break;
-    case RT_SENSOR_CLASS_GYRO:
-        LOG_I("num:%3d, x:%8d, y:%8d, z:%8d dps, timestamp:%5d", num, sensor_data->data.gyro.x / 1000, sensor_data->data.gyro.y / 1000, sensor_data->data.gyro.z / 1000, sensor_data->timestamp);
-        break;
-    case RT_SENSOR_CLASS_MAG:
-        LOG_I("num:%3d, x:%5d, y:%5d, z:%5d mGauss, timestamp:%5d", num, sensor_data->data.mag.x, sensor_data->data.mag.y, sensor_data->data.mag.z, sensor_data->timestamp);
-        break;
-    case RT_SENSOR_CLASS_HUMI:
-        if (sensor_data->data.temp <= 950)
-        {
-            LOG_I("humi:%3d.%d%%, timestamp:%5d",sensor_data->data.humi / 10, sensor_data->data.humi % 10, sensor_data->timestamp);
-        }
-        break;
-    case RT_SENSOR_CLASS_TEMP:
-        if (sensor_data->data.temp <=1400)
-        {
-            LOG_I("temp:%3d.%dC, timestamp:%5d", sensor_data->data.temp / 10, sensor_data->data.temp % 10, sensor_data->timestamp);
-        }
-        break;
-    case RT_SENSOR_CLASS_BARO:
-        LOG_I("num:%3d, press:%5d pa, timestamp:%5d", num, sensor_data->data.baro, sensor_data->timestamp);
-        break;
-    case RT_SENSOR_CLASS_STEP:
-        LOG_I("num:%3d, step:%5d, timestamp:%5d", num, sensor_data->data.step, sensor_data->timestamp);
-        break;
-    case RT_SENSOR_CLASS_PROXIMITY:
-        LOG_I("num:%3d, distance:%5d, timestamp:%5d", num, sensor_data->data.proximity, sensor_data->timestamp);
-        break;
-    case RT_SENSOR_CLASS_FORCE:
-        LOG_I("num:%3d, force:%5d, timestamp:%5d", num, sensor_data->data.force, sensor_data->timestamp);
-//add bh1750
-    case RT_SENSOR_CLASS_LIGHT:
-        LOG_I("num:%3d, light:%4d.%d, timestamp:%5d", num, sensor_data->data.light / 10, sensor_data->data.light % 10, sensor_data->timestamp);
-//    case RT_SENSOR_CLASS_LIGHT:
-//        LOG_I("num:%3d, light:%4d.%d", num, sensor_data->data.light / 10, sensor_data->data.light % 10);      
-        break;
-    default:
-        break;
-    }
-}
-
-static rt_err_t rx_callback(rt_device_t dev, rt_size_t size)
-{
-    rt_sem_release(sensor_rx_sem);
-    return 0;
-}
-
-static void sensor_fifo_rx_entry(void *parameter)
-{
-    rt_device_t dev = (rt_device_t)parameter;
-    rt_sensor_t sensor = (rt_sensor_t)parameter;
-    struct rt_sensor_data *data = RT_NULL;
-    struct rt_sensor_info info;
-    rt_size_t res, i;
-    
-    rt_device_control(dev, RT_SENSOR_CTRL_GET_INFO, &info);
-
-    data = (struct rt_sensor_data *)rt_malloc(sizeof(struct rt_sensor_data) * info.fifo_max);
-    if (data == RT_NULL)
-    {
-        LOG_E("Memory allocation failed!");
-    }
-
-    while (1)
-    {
-        rt_sem_take(sensor_rx_sem, RT_WAITING_FOREVER);
-
-        res = rt_device_read(dev, 0, data, info.fifo_max);
-        for (i = 0; i < res; i++)
-        {
-            sensor_show_data(i, sensor, &data[i]);
-        }
-    }
-}
-
-static void sensor_fifo(int argc, char **argv)
-{
-    static rt_thread_t tid1 = RT_NULL;
-    rt_device_t dev = RT_NULL;
-    rt_sensor_t sensor;
-
-    dev = rt_device_find(argv[1]);
-    if (dev == RT_NULL)
-    {
-        LOG_E("Can't find device:%s", argv[1]);
-        return;
-    }
-    sensor = (rt_sensor_t)dev;
-    
-    if (rt_device_open(dev, RT_DEVICE_FLAG_FIFO_RX) != RT_EOK)
-    {
-        LOG_E("open device failed!");
-        return;
-    }
-
-    if (sensor_rx_sem == RT_NULL)
-    {
-        sensor_rx_sem = rt_sem_create("sen_rx_sem", 0, RT_IPC_FLAG_FIFO);
-    }
-    else
-    {
-        LOG_E("The thread is running, please reboot and try again");
-        return;
-    }
-
-    tid1 = rt_thread_create("sen_rx_thread",
-                            sensor_fifo_rx_entry, sensor,
-                            1024,
-                            15, 5);
-
-    if (tid1 != RT_NULL)
-        rt_thread_startup(tid1);
-
-    rt_device_set_rx_indicate(dev, rx_callback);
-
-    rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)20);
-}
-#ifdef FINSH_USING_MSH
-MSH_CMD_EXPORT(sensor_fifo, Sensor fifo mode test function);
-#endif
-
-static void sensor_irq_rx_entry(void *parameter)
-{
-    rt_device_t dev = (rt_device_t)parameter;
-    rt_sensor_t sensor = (rt_sensor_t)parameter;
-    struct rt_sensor_data data;
-    rt_size_t res, i = 0;
-
-    while (1)
-    {
-        rt_sem_take(sensor_rx_sem, RT_WAITING_FOREVER);
-
-        res = rt_device_read(dev, 0, &data, 1);
-        if (res == 1)
-        {
-            sensor_show_data(i++, sensor, &data);
-        }
-    }
-}
-
-static void sensor_int(int argc, char **argv)
-{
-    static rt_thread_t tid1 = RT_NULL;
-    rt_device_t dev = RT_NULL;
-    rt_sensor_t sensor;
-
-    dev = rt_device_find(argv[1]);
-    if (dev == RT_NULL)
-    {
-        LOG_E("Can't find device:%s", argv[1]);
-        return;
-    }
-    sensor = (rt_sensor_t)dev;
-
-    if (sensor_rx_sem == RT_NULL)
-    {
-        sensor_rx_sem = rt_sem_create("sen_rx_sem", 0, RT_IPC_FLAG_FIFO);
-    }
-    else
-    {
-        LOG_E("The thread is running, please reboot and try again");
-        return;
-    }
-
-    tid1 = rt_thread_create("sen_rx_thread",
-                            sensor_irq_rx_entry, sensor,
-                            1024,
-                            15, 5);
-
-    if (tid1 != RT_NULL)
-        rt_thread_startup(tid1);
-
-    rt_device_set_rx_indicate(dev, rx_callback);
-
-    if (rt_device_open(dev, RT_DEVICE_FLAG_INT_RX) != RT_EOK)
-    {
-        LOG_E("open device failed!");
-        return;
-    }
-    rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)20);
-}
-#ifdef FINSH_USING_MSH
-MSH_CMD_EXPORT(sensor_int, Sensor interrupt mode test function);
-#endif
-
-static void sensor_polling(int argc, char **argv)
-{
-    uint16_t num = 10;
-    rt_device_t dev = RT_NULL;
-    rt_sensor_t sensor;
-    struct rt_sensor_data data;
-    rt_size_t res, i;
-
-    dev = rt_device_find(argv[1]);
-    if (dev == RT_NULL)
-    {
-        LOG_E("Can't find device:%s", argv[1]);
-        return;
-    }
-    if (argc > 2)
-        num = atoi(argv[2]);
-
-    sensor = (rt_sensor_t)dev;
-
-    if (rt_device_open(dev, RT_DEVICE_FLAG_RDWR) != RT_EOK)
-    {
-        LOG_E("open device failed!");
-        return;
-    }
-    rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)100);
-
-    for (i = 0; i < num; i++)
-    {
-        res = rt_device_read(dev, 0, &data, 1);
-        if (res != 1)
-        {
-            LOG_E("read data failed!size is %d", res);
-        }
-        else
-        {
-            sensor_show_data(i, sensor, &data);
-        }
-        rt_thread_mdelay(100);
-    }
-    rt_device_close(dev);
-}
-#ifdef FINSH_USING_MSH
-MSH_CMD_EXPORT(sensor_polling, Sensor polling mode test function);
-#endif
-
-static void sensor(int argc, char **argv)
-{
-    static rt_device_t dev = RT_NULL;
-    struct rt_sensor_data data;
-    rt_size_t res, i;
-
-    /* If the number of arguments less than 2 */
-    if (argc < 2)
-    {
-        rt_kprintf("\n");
-        rt_kprintf("sensor  [OPTION] [PARAM]\n");
-        rt_kprintf("         probe <dev_name>      Probe sensor by given name\n");
-        rt_kprintf("         info                  Get sensor info\n");
-        rt_kprintf("         sr <var>              Set range to var\n");
-        rt_kprintf("         sm <var>              Set work mode to var\n");
-        rt_kprintf("         sp <var>              Set power mode to var\n");
-        rt_kprintf("         sodr <var>            Set output date rate to var\n");
-        rt_kprintf("         read [num]            Read [num] times sensor\n");
-        rt_kprintf("                               num default 5\n");
-        return ;
-    }
-    else if (!strcmp(argv[1], "info"))
-    {
-        struct rt_sensor_info info;
-        if (dev == RT_NULL)
-        {
-            LOG_W("Please probe sensor device first!");
-            return ;
-        }
-        rt_device_control(dev, RT_SENSOR_CTRL_GET_INFO, &info);
-        switch (info.vendor)
-        {
-            case RT_SENSOR_VENDOR_UNKNOWN:
-                rt_kprintf("vendor    :unknown vendor\n");
-                break;
-            case RT_SENSOR_VENDOR_STM:
-                rt_kprintf("vendor    :STMicroelectronics\n");
-                break;
-            case RT_SENSOR_VENDOR_BOSCH:
-                rt_kprintf("vendor    :Bosch\n");
-                break;
-            case RT_SENSOR_VENDOR_INVENSENSE:
-                rt_kprintf("vendor    :Invensense\n");
-                break;
-            case RT_SENSOR_VENDOR_SEMTECH:
-                rt_kprintf("vendor    :Semtech\n");
-                break;
-            case RT_SENSOR_VENDOR_GOERTEK:
-                rt_kprintf("vendor    :Goertek\n");
-                break;
-            case RT_SENSOR_VENDOR_MIRAMEMS:
-                rt_kprintf("vendor    :MiraMEMS\n");
-                break;
-            case RT_SENSOR_VENDOR_DALLAS:
-                rt_kprintf("vendor    :Dallas\n");
-                break;
-        }
-        rt_kprintf("model     :%s\n", info.model);
-        switch (info.unit)
-        {
-            case RT_SENSOR_UNIT_NONE:
-                rt_kprintf("unit      :none\n");
-                break;
-            case RT_SENSOR_UNIT_MG:
-                rt_kprintf("unit      :mG\n");
-                break;
-            case RT_SENSOR_UNIT_MDPS:
-                rt_kprintf("unit      :mdps\n");
-                break;
-            case RT_SENSOR_UNIT_MGAUSS:
-                rt_kprintf("unit      :mGauss\n");
-                break;
-            case RT_SENSOR_UNIT_LUX:
-                rt_kprintf("unit      :lux\n");
-                break;
-            case RT_SENSOR_UNIT_CM:
-                rt_kprintf("unit      :cm\n");
-                break;
-            case RT_SENSOR_UNIT_PA:
-                rt_kprintf("unit      :pa\n");
-                break;
-            case RT_SENSOR_UNIT_PERMILLAGE:
-                rt_kprintf("unit      :permillage\n");
-                break;
-            case RT_SENSOR_UNIT_DCELSIUS:
-                rt_kprintf("unit      :Celsius\n");
-                break;
-            case RT_SENSOR_UNIT_HZ:
-                rt_kprintf("unit      :HZ\n");
-                break;
-            case RT_SENSOR_UNIT_ONE:
-                rt_kprintf("unit      :1\n");
-                break;
-            case RT_SENSOR_UNIT_BPM:
-                rt_kprintf("unit      :bpm\n");
-                break;
-            case RT_SENSOR_UNIT_MM:
-                rt_kprintf("unit      :mm\n");
-                break;
-            case RT_SENSOR_UNIT_MN:
-                rt_kprintf("unit      :mN\n");
-                break;
-        }
-        rt_kprintf("range_max :%d\n", info.range_max);
-        rt_kprintf("range_min :%d\n", info.range_min);
-        rt_kprintf("period_min:%dms\n", info.period_min);
-        rt_kprintf("fifo_max  :%d\n", info.fifo_max);
-    }
-    else if (!strcmp(argv[1], "read"))
-    {
-        uint16_t num = 5;
-
-        if (dev == RT_NULL)
-        {
-            LOG_W("Please probe sensor device first!");
-            return ;
-        }
-        if (argc == 3)
-        {
-            num = atoi(argv[2]);
-        }
-
-        for (i = 0; i < num; i++)
-        {
-            res = rt_device_read(dev, 0, &data, 1);
-            if (res != 1)
-            {
-                LOG_E("read data failed!size is %d", res);
-            }
-            else
-            {
-                sensor_show_data(i, (rt_sensor_t)dev, &data);
-            }
-            rt_thread_mdelay(100);
-        }
-    }
-    else if (argc == 3)
-    {
-        if (!strcmp(argv[1], "probe"))
-        {
-            rt_uint8_t reg = 0xFF;
-            if (dev)
-            {
-                rt_device_close(dev);
-            }
-
-            dev = rt_device_find(argv[2]);
-            if (dev == RT_NULL)
-            {
-                LOG_E("Can't find device:%s", argv[1]);
-                return;
-            }
-            if (rt_device_open(dev, RT_DEVICE_FLAG_RDWR) != RT_EOK)
-            {
-                LOG_E("open device failed!");
-                return;
-            }
-            rt_device_control(dev, RT_SENSOR_CTRL_GET_ID, &reg);
-            LOG_I("device id: 0x%x!", reg);
-
-        }
-        else if (dev == RT_NULL)
-        {
-            LOG_W("Please probe sensor first!");
-            return ;
-        }
-        else if (!strcmp(argv[1], "sr"))
-        {
-            rt_device_control(dev, RT_SENSOR_CTRL_SET_RANGE, (void *)atoi(argv[2]));
-        }
-        else if (!strcmp(argv[1], "sm"))
-        {
-            rt_device_control(dev, RT_SENSOR_CTRL_SET_MODE, (void *)atoi(argv[2]));
-        }
-        else if (!strcmp(argv[1], "sp"))
-        {
-            rt_device_control(dev, RT_SENSOR_CTRL_SET_POWER, (void *)atoi(argv[2]));
-        }
-        else if (!strcmp(argv[1], "sodr"))
-        {
-            rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)atoi(argv[2]));
-        }
-        else
-        {
-            LOG_W("Unknown command, please enter 'sensor' get help information!");
-        }
-    }
-    else
-    {
-        LOG_W("Unknown command, please enter 'sensor' get help information!");
-    }
-}
-#ifdef FINSH_USING_MSH
-MSH_CMD_EXPORT(sensor, sensor test function);
-#endif
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author         Notes
+ * 2019-01-31     flybreak       first version
+ * 2019-07-16     WillianChan    Increase the output of sensor information
+ */
+
+#include "sensor.h"
+
+#define DBG_TAG  "sensor.cmd"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#include <stdlib.h>
+//add header
+#include <stdint.h>
+#include <string.h>
+
+#if defined(RT_SENSOR_USING_RECORD) && defined(RT_USING_DFS)
+#include <dfs_posix.h>
+
+/* The log files, the fd of a replay stays open as long as its sensor */
+static rt_size_t sensor_record_file_write(const void *buf, rt_size_t size, void *user_data)
+{
+    int len = write((int)(rt_base_t)user_data, buf, size);
+
+    return len < 0 ? 0 : len;
+}
+
+static rt_size_t sensor_record_file_read(void *buf, rt_size_t size, void *user_data)
+{
+    int len = read((int)(rt_base_t)user_data, buf, size);
+
+    return len < 0 ? 0 : len;
+}
+
+static int sensor_record_fd = -1;
+#endif
+
+/* The device name as a C string, it fills its RT_NAME_MAX bytes without a terminator */
+static const char *sensor_dev_name(rt_sensor_t sensor, char buf[RT_NAME_MAX + 1])
+{
+    rt_strncpy(buf, sensor->parent.parent.name, RT_NAME_MAX);
+    buf[RT_NAME_MAX] = '\0';
+
+    return buf;
+}
+
+static void sensor_show_data(rt_size_t num, rt_sensor_t sensor, struct rt_sensor_data *sensor_data)
+{
+    switch (sensor->info.type)
+    {
+    case RT_SENSOR_CLASS_ACCE:
+        LOG_I("num:%3d, x:%5d, y:%5d, z:%5d mg, timestamp:%5d", num, sensor_data->data.acce.x, sensor_data->data.acce.y, sensor_data->data.acce.z, sensor_data->timestamp);
+        break;
+    case RT_SENSOR_CLASS_GYRO:
+        LOG_I("num:%3d, x:%8d, y:%8d, z:%8d dps, timestamp:%5d", num, sensor_data->data.gyro.x / 1000, sensor_data->data.gyro.y / 1000, sensor_data->data.gyro.z / 1000, sensor_data->timestamp);
+        break;
+    case RT_SENSOR_CLASS_MAG:
+        LOG_I("num:%3d, x:%5d, y:%5d, z:%5d mGauss, timestamp:%5d", num, sensor_data->data.mag.x, sensor_data->data.mag.y, sensor_data->data.mag.z, sensor_data->timestamp);
+        break;
+    case RT_SENSOR_CLASS_HUMI:
+        if (sensor_data->data.temp <= 950)
+        {
+            LOG_I("humi:%3d.%d%%, timestamp:%5d",sensor_data->data.humi / 10, sensor_data->data.humi % 10, sensor_data->timestamp);
+        }
+        break;
+    case RT_SENSOR_CLASS_TEMP:
+        if (sensor_data->data.temp <=1400)
+        {
+            LOG_I("temp:%3d.%dC, timestamp:%5d", sensor_data->data.temp / 10, sensor_data->data.temp % 10, sensor_data->timestamp);
+        }
+        break;
+    case RT_SENSOR_CLASS_BARO:
+        LOG_I("num:%3d, press:%5d pa, timestamp:%5d", num, sensor_data->data.baro, sensor_data->timestamp);
+        break;
+    case RT_SENSOR_CLASS_STEP:
+        LOG_I("num:%3d, step:%5d, timestamp:%5d", num, sensor_data->data.step, sensor_data->timestamp);
+        break;
+    case RT_SENSOR_CLASS_PROXIMITY:
+        LOG_I("num:%3d, distance:%5d, timestamp:%5d", num, sensor_data->data.proximity, sensor_data->timestamp);
+        break;
+    case RT_SENSOR_CLASS_FORCE:
+        LOG_I("num:%3d, force:%5d, timestamp:%5d", num, sensor_data->data.force, sensor_data->timestamp);
+//add bh1750
+    case RT_SENSOR_CLASS_LIGHT:
+        LOG_I("num:%3d, light:%4d.%d, timestamp:%5d", num, sensor_data->data.light / 10, sensor_data->data.light % 10, sensor_data->timestamp);
+//    case RT_SENSOR_CLASS_LIGHT:
+//        LOG_I("num:%3d, light:%4d.%d", num, sensor_data->data.light / 10, sensor_data->data.light % 10);      
+        break;
+    default:
+        break;
+    }
+}
+
+#define SENSOR_RX_TIMEOUT_MS        2000    /* Give up waiting for a sample after this */
+
+static rt_err_t rx_callback(struct rt_sensor_subscriber *sub, rt_size_t size)
+{
+    rt_sem_release((rt_sem_t)sub->user_data);
+    return 0;
+}
+
+/* Every test command gets a subscriber of its own, so they can share a sensor */
+static struct rt_sensor_subscriber *sensor_rx_subscribe(rt_sensor_t sensor, rt_uint16_t decimation)
+{
+    struct rt_sensor_subscriber *sub;
+    rt_sem_t sem;
+
+    sub = (struct rt_sensor_subscriber *)rt_malloc(sizeof(struct rt_sensor_subscriber));
+    if (sub == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    sem = rt_sem_create("sen_rx_sem", 0, RT_IPC_FLAG_FIFO);
+    if (sem == RT_NULL)
+    {
+        rt_free(sub);
+        return RT_NULL;
+    }
+
+    rt_sensor_subscribe(sensor, sub, decimation, rx_callback, sem);
+
+    return sub;
+}
+
+static void sensor_rx_unsubscribe(struct rt_sensor_subscriber *sub)
+{
+    rt_sensor_unsubscribe(sub);
+    rt_sem_delete((rt_sem_t)sub->user_data);
+    rt_free(sub);
+}
+
+/* A consumer of sensor_fifo or sensor_int, its thread shows 'num' samples and cleans up */
+struct sensor_rx_consumer
+{
+    struct rt_sensor_subscriber *sub;
+    rt_size_t                    num;
+    rt_bool_t                    opened;    /* This consumer opened the device, it closes it */
+};
+
+static struct sensor_rx_consumer *sensor_rx_consumer_create(rt_sensor_t sensor, rt_uint16_t decimation, rt_size_t num)
+{
+    struct sensor_rx_consumer *rx;
+
+    rx = (struct sensor_rx_consumer *)rt_malloc(sizeof(struct sensor_rx_consumer));
+    if (rx == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    rx->sub = sensor_rx_subscribe(sensor, decimation);
+    if (rx->sub == RT_NULL)
+    {
+        rt_free(rx);
+        return RT_NULL;
+    }
+    rx->num = num;
+    rx->opened = RT_FALSE;
+
+    return rx;
+}
+
+static void sensor_rx_consumer_delete(struct sensor_rx_consumer *rx)
+{
+    if (rx->opened)
+    {
+        rt_device_close(&rx->sub->sensor->parent);
+    }
+    sensor_rx_unsubscribe(rx->sub);
+    rt_free(rx);
+}
+
+/* A second consumer joins the sensor already opened by the first one, which closes it */
+static rt_err_t sensor_rx_consumer_start(struct sensor_rx_consumer *rx, rt_uint16_t oflag,
+                                         void (*entry)(void *parameter))
+{
+    rt_device_t dev = &rx->sub->sensor->parent;
+    rt_thread_t tid;
+
+    if (dev->ref_count == 0)
+    {
+        if (rt_device_open(dev, oflag) != RT_EOK)
+        {
+            LOG_E("open device failed!");
+            return -RT_ERROR;
+        }
+        rx->opened = RT_TRUE;
+        rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)20);
+    }
+
+    tid = rt_thread_create("sen_rx_thread", entry, rx, 1024, 15, 5);
+    if (tid == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+
+static void sensor_fifo_rx_entry(void *parameter)
+{
+    struct sensor_rx_consumer *rx = (struct sensor_rx_consumer *)parameter;
+    struct rt_sensor_subscriber *sub = rx->sub;
+    rt_sensor_t sensor = sub->sensor;
+    struct rt_sensor_data data[4];
+    rt_size_t res, i, n = 0;
+
+    while (n < rx->num)
+    {
+        if (rt_sem_take((rt_sem_t)sub->user_data, rt_tick_from_millisecond(SENSOR_RX_TIMEOUT_MS)) != RT_EOK)
+        {
+            LOG_E("read data timeout!");
+            break;
+        }
+
+        while (n < rx->num && (res = rt_sensor_subscriber_read(sub, data, sizeof(data) / sizeof(data[0]))) > 0)
+        {
+            for (i = 0; i < res && n < rx->num; i++)
+            {
+                sensor_show_data(n++, sensor, &data[i]);
+            }
+        }
+    }
+    sensor_rx_consumer_delete(rx);
+}
+
+static void sensor_fifo(int argc, char **argv)
+{
+    rt_device_t dev = RT_NULL;
+    struct sensor_rx_consumer *rx;
+    rt_uint16_t decimation = 1;
+    rt_size_t num = 10;
+
+    dev = rt_device_find(argv[1]);
+    if (dev == RT_NULL)
+    {
+        LOG_E("Can't find device:%s", argv[1]);
+        return;
+    }
+    if (argc > 2)
+        decimation = atoi(argv[2]);
+    if (argc > 3)
+        num = atoi(argv[3]);
+
+    rx = sensor_rx_consumer_create((rt_sensor_t)dev, decimation, num);
+    if (rx == RT_NULL)
+    {
+        LOG_E("subscribe failed!");
+        return;
+    }
+
+    if (sensor_rx_consumer_start(rx, RT_DEVICE_FLAG_FIFO_RX, sensor_fifo_rx_entry) != RT_EOK)
+    {
+        sensor_rx_consumer_delete(rx);
+    }
+}
+#ifdef FINSH_USING_MSH
+MSH_CMD_EXPORT(sensor_fifo, Sensor fifo mode test function: sensor_fifo <dev> [decimation] [num]);
+#endif
+
+static void sensor_irq_rx_entry(void *parameter)
+{
+    struct sensor_rx_consumer *rx = (struct sensor_rx_consumer *)parameter;
+    struct rt_sensor_subscriber *sub = rx->sub;
+    rt_sensor_t sensor = sub->sensor;
+    rt_device_t dev = &sensor->parent;
+    struct rt_sensor_data data;
+    rt_size_t res, i = 0;
+
+    while (i < rx->num)
+    {
+        if (rt_sem_take((rt_sem_t)sub->user_data, rt_tick_from_millisecond(SENSOR_RX_TIMEOUT_MS)) != RT_EOK)
+        {
+            LOG_E("read data timeout!");
+            break;
+        }
+
+        /* A sample buffered by the driver is shared, otherwise fetch it */
+        res = rt_sensor_subscriber_read(sub, &data, 1);
+        if (res == 0)
+        {
+            res = rt_device_read(dev, 0, &data, 1);
+        }
+        if (res == 1)
+        {
+            sensor_show_data(i++, sensor, &data);
+        }
+    }
+    sensor_rx_consumer_delete(rx);
+}
+
+static void sensor_int(int argc, char **argv)
+{
+    rt_device_t dev = RT_NULL;
+    struct sensor_rx_consumer *rx;
+    rt_size_t num = 10;
+
+    dev = rt_device_find(argv[1]);
+    if (dev == RT_NULL)
+    {
+        LOG_E("Can't find device:%s", argv[1]);
+        return;
+    }
+    if (argc > 2)
+        num = atoi(argv[2]);
+
+    rx = sensor_rx_consumer_create((rt_sensor_t)dev, 1, num);
+    if (rx == RT_NULL)
+    {
+        LOG_E("subscribe failed!");
+        return;
+    }
+
+    if (sensor_rx_consumer_start(rx, RT_DEVICE_FLAG_INT_RX, sensor_irq_rx_entry) != RT_EOK)
+    {
+        sensor_rx_consumer_delete(rx);
+    }
+}
+#ifdef FINSH_USING_MSH
+MSH_CMD_EXPORT(sensor_int, Sensor interrupt mode test function: sensor_int <dev> [num]);
+#endif
+
+/* The sampling scheduler polls the driver, the caller only sleeps until a sample is published */
+static void sensor_polling_sched(rt_device_t dev, rt_size_t num)
+{
+    rt_sensor_t sensor = (rt_sensor_t)dev;
+    struct rt_sensor_subscriber *sub;
+    struct rt_sensor_data data;
+    rt_size_t i = 0;
+
+    sub = sensor_rx_subscribe(sensor, 1);
+    if (sub == RT_NULL)
+    {
+        LOG_E("subscribe failed!");
+        return;
+    }
+
+    if (rt_device_open(dev, RT_DEVICE_FLAG_FIFO_RX) != RT_EOK)
+    {
+        LOG_E("open device failed!");
+        sensor_rx_unsubscribe(sub);
+        return;
+    }
+    rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)10);
+
+    while (i < num)
+    {
+        if (rt_sem_take((rt_sem_t)sub->user_data, rt_tick_from_millisecond(SENSOR_RX_TIMEOUT_MS)) != RT_EOK)
+        {
+            LOG_E("read data timeout!");
+            break;
+        }
+
+        while (i < num && rt_sensor_subscriber_read(sub, &data, 1) == 1)
+        {
+            sensor_show_data(i++, sensor, &data);
+        }
+    }
+    rt_device_close(dev);
+    sensor_rx_unsubscribe(sub);
+}
+
+static void sensor_polling(int argc, char **argv)
+{
+    uint16_t num = 10;
+    rt_device_t dev = RT_NULL;
+    rt_sensor_t sensor;
+    struct rt_sensor_data data;
+    rt_size_t res, i;
+
+    dev = rt_device_find(argv[1]);
+    if (dev == RT_NULL)
+    {
+        LOG_E("Can't find device:%s", argv[1]);
+        return;
+    }
+    if (argc > 2)
+        num = atoi(argv[2]);
+
+    sensor = (rt_sensor_t)dev;
+
+    /* A sensor with an irq pin would be opened on the irq fifo, which the driver does not fetch into */
+    if ((dev->flag & RT_DEVICE_FLAG_FIFO_RX) && sensor->config.irq_pin.pin == RT_PIN_NONE)
+    {
+        sensor_polling_sched(dev, num);
+        return;
+    }
+
+    if (rt_device_open(dev, RT_DEVICE_FLAG_RDWR) != RT_EOK)
+    {
+        LOG_E("open device failed!");
+        return;
+    }
+    rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)100);
+
+    for (i = 0; i < num; i++)
+    {
+        res = rt_device_read(dev, 0, &data, 1);
+        if (res != 1)
+        {
+            LOG_E("read data failed!size is %d", res);
+        }
+        else
+        {
+            sensor_show_data(i, sensor, &data);
+        }
+        rt_thread_mdelay(100);
+    }
+    rt_device_close(dev);
+}
+#ifdef FINSH_USING_MSH
+MSH_CMD_EXPORT(sensor_polling, Sensor polling mode test function);
+#endif
+
+/*
+ * sensor_bench: read a sensor n times, as fast as possible or paced to a
+ * target odr, and report throughput and latency. In poll mode the latency
+ * is the time spent in rt_device_read(); in int and fifo mode it is the age
+ * of the sample when the consumer gets it. The CPU time is taken from the
+ * idle hook, so it covers the whole system while the bench runs. Telling a
+ * preempted idle from a running one takes a clock much finer than the gap,
+ * without one registered with rt_sensor_clock_register() no CPU figure is
+ * given.
+ */
+#define SENSOR_BENCH_IDLE_GAP_US    100     /* A longer gap between idle hook calls means idle was preempted */
+#define SENSOR_BENCH_TIMEOUT_MS     2000    /* Give up waiting for a sample after this */
+
+#ifdef RT_USING_IDLE_HOOK
+static rt_uint64_t sensor_bench_idle_us;
+static rt_uint64_t sensor_bench_idle_last;
+
+static void sensor_bench_idle_hook(void)
+{
+    rt_uint64_t now = rt_sensor_get_ts_us();
+
+    if (now - sensor_bench_idle_last < SENSOR_BENCH_IDLE_GAP_US)
+    {
+        sensor_bench_idle_us += now - sensor_bench_idle_last;
+    }
+    sensor_bench_idle_last = now;
+}
+#endif
+
+static int sensor_bench_cmp(const void *a, const void *b)
+{
+    rt_uint32_t x = *(const rt_uint32_t *)a, y = *(const rt_uint32_t *)b;
+
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/* Returns the number of samples read, lat[] gets one latency per sample */
+static rt_size_t sensor_bench_poll(rt_device_t dev, rt_uint32_t *lat, rt_size_t num, rt_uint16_t odr)
+{
+    struct rt_sensor_data data;
+    rt_uint64_t start, begin, end, next;
+    rt_size_t i, count = 0;
+
+    start = rt_sensor_get_ts_us();
+    for (i = 0; i < num; i++)
+    {
+        if (odr > 0)
+        {
+            /* Pace against the start time, so a slow read does not shift the following ones */
+            next = start + (rt_uint64_t)i * 1000000 / odr;
+            begin = rt_sensor_get_ts_us();
+            if (next > begin + 1000)
+            {
+                rt_thread_mdelay((rt_int32_t)((next - begin) / 1000));
+            }
+        }
+
+        begin = rt_sensor_get_ts_us();
+        if (rt_device_read(dev, 0, &data, 1) == 1)
+        {
+            end = rt_sensor_get_ts_us();
+            lat[count++] = (rt_uint32_t)(end - begin);
+        }
+    }
+
+    return count;
+}
+
+static rt_size_t sensor_bench_rx(rt_device_t dev, rt_uint32_t *lat, rt_size_t num)
+{
+    rt_sensor_t sensor = (rt_sensor_t)dev;
+    struct rt_sensor_subscriber *sub;
+    struct rt_sensor_data data;
+    rt_size_t res, count = 0;
+
+    sub = sensor_rx_subscribe(sensor, 1);
+    if (sub == RT_NULL)
+    {
+        LOG_E("subscribe failed!");
+        return 0;
+    }
+
+    while (count < num)
+    {
+        if (rt_sem_take((rt_sem_t)sub->user_data, rt_tick_from_millisecond(SENSOR_BENCH_TIMEOUT_MS)) != RT_EOK)
+        {
+            LOG_W("no sample for %dms, stop", SENSOR_BENCH_TIMEOUT_MS);
+            break;
+        }
+
+        do
+        {
+            res = rt_sensor_subscriber_read(sub, &data, 1);
+            if (res == 0 && sensor->config.mode == RT_SENSOR_MODE_INT)
+            {
+                res = rt_device_read(dev, 0, &data, 1);
+            }
+            if (res == 1 && data.timestamp_us != 0)
+            {
+                lat[count++] = (rt_uint32_t)(rt_sensor_get_ts_us() - data.timestamp_us);
+            }
+        }
+        while (res == 1 && count < num && sensor->config.mode == RT_SENSOR_MODE_FIFO);
+    }
+
+    sensor_rx_unsubscribe(sub);
+    return count;
+}
+
+static void sensor_bench(int argc, char **argv)
+{
+    rt_device_t dev = RT_NULL;
+    rt_uint32_t *lat;
+    rt_uint16_t oflag, odr = 0;
+    rt_size_t num, count, i;
+    rt_uint64_t start, elapsed, sum = 0;
+    rt_bool_t opened = RT_FALSE;
+
+    if (argc < 4)
+    {
+        rt_kprintf("sensor_bench <dev> <poll|int|fifo> <n> [odr]\n");
+        return;
+    }
+
+    dev = rt_device_find(argv[1]);
+    if (dev == RT_NULL)
+    {
+        LOG_E("Can't find device:%s", argv[1]);
+        return;
+    }
+    if (!strcmp(argv[2], "poll"))
+        oflag = RT_DEVICE_FLAG_RDWR;
+    else if (!strcmp(argv[2], "int"))
+        oflag = RT_DEVICE_FLAG_INT_RX;
+    else if (!strcmp(argv[2], "fifo"))
+        oflag = RT_DEVICE_FLAG_FIFO_RX;
+    else
+    {
+        LOG_E("Unknown mode:%s", argv[2]);
+        return;
+    }
+    num = atoi(argv[3]);
+    if (argc > 4)
+        odr = atoi(argv[4]);
+    if (num == 0)
+        return;
+
+    lat = (rt_uint32_t *)rt_malloc(sizeof(rt_uint32_t) * num);
+    if (lat == RT_NULL)
+    {
+        LOG_E("no memory for %d samples", num);
+        return;
+    }
+
+    if (dev->ref_count == 0)
+    {
+        if (rt_device_open(dev, oflag) != RT_EOK)
+        {
+            LOG_E("open device failed!");
+            rt_free(lat);
+            return;
+        }
+        opened = RT_TRUE;
+    }
+    if (odr > 0)
+    {
+        rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)(rt_uint32_t)odr);
+    }
+
+#ifdef RT_USING_IDLE_HOOK
+    sensor_bench_idle_us = 0;
+    sensor_bench_idle_last = rt_sensor_get_ts_us();
+    rt_thread_idle_sethook(sensor_bench_idle_hook);
+#endif
+    start = rt_sensor_get_ts_us();
+
+    if (oflag == RT_DEVICE_FLAG_RDWR)
+        count = sensor_bench_poll(dev, lat, num, odr);
+    else
+        count = sensor_bench_rx(dev, lat, num);
+
+    elapsed = rt_sensor_get_ts_us() - start + 1;
+#ifdef RT_USING_IDLE_HOOK
+    rt_thread_idle_delhook(sensor_bench_idle_hook);
+#endif
+
+    if (opened)
+    {
+        rt_device_close(dev);
+    }
+
+    if (count == 0)
+    {
+        LOG_E("no sample read");
+        rt_free(lat);
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        sum += lat[i];
+    }
+    qsort(lat, count, sizeof(rt_uint32_t), sensor_bench_cmp);
+
+    rt_kprintf("%s %s: %d/%d samples in %dms, %d.%02d samples/s\n", argv[1], argv[2], count, num,
+               (rt_uint32_t)(elapsed / 1000), (rt_uint32_t)(count * 1000000ULL / elapsed),
+               (rt_uint32_t)(count * 100000000ULL / elapsed % 100));
+    rt_kprintf("latency us: min %d avg %d p99 %d max %d\n", lat[0], (rt_uint32_t)(sum / count),
+               lat[(count * 99 - 1) / 100], lat[count - 1]);
+#ifdef RT_USING_IDLE_HOOK
+    if (rt_sensor_get_ts_res_us() * 10 > SENSOR_BENCH_IDLE_GAP_US)
+    {
+        rt_kprintf("cpu: n/a, the clock resolution of %dus is too coarse, register a faster counter\n",
+                   rt_sensor_get_ts_res_us());
+    }
+    else
+    {
+        rt_uint64_t busy = elapsed > sensor_bench_idle_us ? elapsed - sensor_bench_idle_us : 0;
+
+        rt_kprintf("cpu: %dus per sample, %d%% busy\n", (rt_uint32_t)(busy / count), (rt_uint32_t)(busy * 100 / elapsed));
+    }
+#else
+    rt_kprintf("cpu: n/a, needs RT_USING_IDLE_HOOK\n");
+#endif
+
+    rt_free(lat);
+}
+#ifdef FINSH_USING_MSH
+MSH_CMD_EXPORT(sensor_bench, Sensor throughput and latency: sensor_bench <dev> <poll|int|fifo> <n> [odr]);
+#endif
+
+#ifdef RT_SENSOR_USING_STATS
+static void sensor_show_stats(rt_sensor_t sensor)
+{
+    struct rt_sensor_stats *stats = &sensor->stats;
+    rt_uint32_t i, avg = 0;
+    char name[RT_NAME_MAX + 1];
+
+    if (stats->fetches > 0)
+    {
+        avg = (rt_uint32_t)(stats->fetch_us_sum / stats->fetches);
+    }
+    rt_kprintf("%-*s read:%u hit:%u fetch:%u fail:%u bus_err:%u range:%u avg:%uus max:%uus\n",
+               RT_NAME_MAX, sensor_dev_name(sensor, name),
+               stats->reads, stats->cache_hits, stats->fetches, stats->fetch_fails,
+               stats->bus_errors, stats->range_drops, avg, stats->fetch_us_max);
+
+    for (i = 0; i < RT_SENSOR_STATS_HIST_BINS; i++)
+    {
+        if (stats->hist[i] != 0)
+        {
+            rt_kprintf("    %8uus%s %u\n", 1u << i, i == RT_SENSOR_STATS_HIST_BINS - 1 ? "+" : " ", stats->hist[i]);
+        }
+    }
+}
+#endif
+
+static void sensor(int argc, char **argv)
+{
+    static rt_device_t dev = RT_NULL;
+    struct rt_sensor_data data;
+    rt_size_t res, i;
+
+    /* If the number of arguments less than 2 */
+    if (argc < 2)
+    {
+        rt_kprintf("\n");
+        rt_kprintf("sensor  [OPTION] [PARAM]\n");
+        rt_kprintf("         probe <dev_name>      Probe sensor by given name\n");
+        rt_kprintf("         list                  List registered sensors by type\n");
+        rt_kprintf("         stats [reset]         Show or clear the counters of all sensors\n");
+        rt_kprintf("         trace [clear]         Dump or clear the event trace ring\n");
+        rt_kprintf("         record <file|stop>    Record the samples read by all sensors to file\n");
+        rt_kprintf("         replay <file> <type> <name> [speed]\n");
+        rt_kprintf("                               Add sensor name playing the type from file\n");
+        rt_kprintf("         info                  Get sensor info\n");
+        rt_kprintf("         sr <var>              Set range to var\n");
+        rt_kprintf("         sm <var>              Set work mode to var\n");
+        rt_kprintf("         sp <var>              Set power mode to var\n");
+        rt_kprintf("         sodr <var>            Set output date rate to var\n");
+        rt_kprintf("         sage <var>            Set max age of a cached read to var ms\n");
+        rt_kprintf("         sidle <var>           Power down after var ms without access, 0 off\n");
+        rt_kprintf("         sspeed <var>          Replay var times faster, 0 one record per read\n");
+        rt_kprintf("         read [num]            Read [num] times sensor\n");
+        rt_kprintf("         last                  Show the latest sample without a bus access\n");
+        rt_kprintf("                               num default 5\n");
+        return ;
+    }
+    else if (!strcmp(argv[1], "list"))
+    {
+        rt_sensor_t sensor;
+        rt_uint8_t type;
+        char name[RT_NAME_MAX + 1];
+
+        for (type = RT_SENSOR_CLASS_NONE + 1; type < RT_SENSOR_CLASS_MAX; type++)
+        {
+            rt_sensor_foreach(sensor, type)
+            {
+                rt_kprintf("%-*s type:%2d vendor:%d model:%s\n", RT_NAME_MAX, sensor_dev_name(sensor, name),
+                           sensor->info.type, sensor->info.vendor, sensor->info.model ? sensor->info.model : "-");
+            }
+        }
+    }
+#ifdef RT_SENSOR_USING_STATS
+    else if (!strcmp(argv[1], "stats"))
+    {
+        rt_sensor_t sensor;
+        rt_uint8_t type;
+
+        for (type = RT_SENSOR_CLASS_NONE + 1; type < RT_SENSOR_CLASS_MAX; type++)
+        {
+            rt_sensor_foreach(sensor, type)
+            {
+                if (argc > 2 && !strcmp(argv[2], "reset"))
+                {
+                    rt_memset(&sensor->stats, 0, sizeof(sensor->stats));
+                }
+                else
+                {
+                    sensor_show_stats(sensor);
+                }
+            }
+        }
+    }
+#endif
+#ifdef RT_SENSOR_USING_TRACE
+    else if (!strcmp(argv[1], "trace"))
+    {
+        if (argc > 2 && !strcmp(argv[2], "clear"))
+        {
+            rt_sensor_trace_clear();
+        }
+        else
+        {
+            rt_sensor_trace_dump();
+        }
+    }
+#endif
+#if defined(RT_SENSOR_USING_RECORD) && defined(RT_USING_DFS)
+    else if (!strcmp(argv[1], "record") && argc > 2)
+    {
+        if (!strcmp(argv[2], "stop"))
+        {
+            rt_sensor_record_stop();
+            if (sensor_record_fd >= 0)
+            {
+                close(sensor_record_fd);
+                sensor_record_fd = -1;
+            }
+        }
+        else if (sensor_record_fd >= 0)
+        {
+            LOG_W("Recording already, stop it first!");
+        }
+        else
+        {
+            sensor_record_fd = open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0);
+            if (sensor_record_fd < 0)
+            {
+                LOG_E("Can't open %s", argv[2]);
+                return ;
+            }
+            if (rt_sensor_record_start(sensor_record_file_write, (void *)(rt_base_t)sensor_record_fd) != RT_EOK)
+            {
+                LOG_E("Record start failed");
+                close(sensor_record_fd);
+                sensor_record_fd = -1;
+            }
+        }
+    }
+    else if (!strcmp(argv[1], "replay") && argc > 4)
+    {
+        int fd = open(argv[2], O_RDONLY, 0);
+
+        if (fd < 0)
+        {
+            LOG_E("Can't open %s", argv[2]);
+            return ;
+        }
+        if (rt_hw_sensor_replay_init(argv[4], atoi(argv[3]), sensor_record_file_read, (void *)(rt_base_t)fd,
+                                     argc > 5 ? atoi(argv[5]) : 1) != RT_EOK)
+        {
+            close(fd);
+        }
+    }
+#endif
+    else if (!strcmp(argv[1], "info"))
+    {
+        struct rt_sensor_info info;
+        if (dev == RT_NULL)
+        {
+            LOG_W("Please probe sensor device first!");
+            return ;
+        }
+        rt_device_control(dev, RT_SENSOR_CTRL_GET_INFO, &info);
+        switch (info.vendor)
+        {
+            case RT_SENSOR_VENDOR_UNKNOWN:
+                rt_kprintf("vendor    :unknown vendor\n");
+                break;
+            case RT_SENSOR_VENDOR_STM:
+                rt_kprintf("vendor    :STMicroelectronics\n");
+                break;
+            case RT_SENSOR_VENDOR_BOSCH:
+                rt_kprintf("vendor    :Bosch\n");
+                break;
+            case RT_SENSOR_VENDOR_INVENSENSE:
+                rt_kprintf("vendor    :Invensense\n");
+                break;
+            case RT_SENSOR_VENDOR_SEMTECH:
+                rt_kprintf("vendor    :Semtech\n");
+                break;
+            case RT_SENSOR_VENDOR_GOERTEK:
+                rt_kprintf("vendor    :Goertek\n");
+                break;
+            case RT_SENSOR_VENDOR_MIRAMEMS:
+                rt_kprintf("vendor    :MiraMEMS\n");
+                break;
+            case RT_SENSOR_VENDOR_DALLAS:
+                rt_kprintf("vendor    :Dallas\n");
+                break;
+        }
+        rt_kprintf("model     :%s\n", info.model);
+        switch (info.unit)
+        {
+            case RT_SENSOR_UNIT_NONE:
+                rt_kprintf("unit      :none\n");
+                break;
+            case RT_SENSOR_UNIT_MG:
+                rt_kprintf("unit      :mG\n");
+                break;
+            case RT_SENSOR_UNIT_MDPS:
+                rt_kprintf("unit      :mdps\n");
+                break;
+            case RT_SENSOR_UNIT_MGAUSS:
+                rt_kprintf("unit      :mGauss\n");
+                break;
+            case RT_SENSOR_UNIT_LUX:
+                rt_kprintf("unit      :lux\n");
+                break;
+            case RT_SENSOR_UNIT_CM:
+                rt_kprintf("unit      :cm\n");
+                break;
+            case RT_SENSOR_UNIT_PA:
+                rt_kprintf("unit      :pa\n");
+                break;
+            case RT_SENSOR_UNIT_PERMILLAGE:
+                rt_kprintf("unit      :permillage\n");
+                break;
+            case RT_SENSOR_UNIT_DCELSIUS:
+                rt_kprintf("unit      :Celsius\n");
+                break;
+            case RT_SENSOR_UNIT_HZ:
+                rt_kprintf("unit      :HZ\n");
+                break;
+            case RT_SENSOR_UNIT_ONE:
+                rt_kprintf("unit      :1\n");
+                break;
+            case RT_SENSOR_UNIT_BPM:
+                rt_kprintf("unit      :bpm\n");
+                break;
+            case RT_SENSOR_UNIT_MM:
+                rt_kprintf("unit      :mm\n");
+                break;
+            case RT_SENSOR_UNIT_MN:
+                rt_kprintf("unit      :mN\n");
+                break;
+        }
+        rt_kprintf("range_max :%d\n", info.range_max);
+        rt_kprintf("range_min :%d\n", info.range_min);
+        rt_kprintf("period_min:%dms\n", info.period_min);
+        rt_kprintf("fifo_max  :%d\n", info.fifo_max);
+    }
+    else if (!strcmp(argv[1], "read"))
+    {
+        uint16_t num = 5;
+
+        if (dev == RT_NULL)
+        {
+            LOG_W("Please probe sensor device first!");
+            return ;
+        }
+        if (argc == 3)
+        {
+            num = atoi(argv[2]);
+        }
+
+        for (i = 0; i < num; i++)
+        {
+            res = rt_device_read(dev, 0, &data, 1);
+            if (res != 1)
+            {
+                LOG_E("read data failed!size is %d", res);
+            }
+            else
+            {
+                sensor_show_data(i, (rt_sensor_t)dev, &data);
+            }
+            rt_thread_mdelay(100);
+        }
+    }
+    else if (!strcmp(argv[1], "last"))
+    {
+        if (dev == RT_NULL)
+        {
+            LOG_W("Please probe sensor device first!");
+            return ;
+        }
+        if (rt_sensor_get_last((rt_sensor_t)dev, &data) != RT_EOK)
+        {
+            LOG_W("No sample yet!");
+            return ;
+        }
+        sensor_show_data(0, (rt_sensor_t)dev, &data);
+    }
+    else if (argc == 3)
+    {
+        if (!strcmp(argv[1], "probe"))
+        {
+            rt_uint8_t reg = 0xFF;
+            if (dev)
+            {
+                rt_device_close(dev);
+            }
+
+            dev = rt_device_find(argv[2]);
+            if (dev == RT_NULL)
+            {
+                LOG_E("Can't find device:%s", argv[1]);
+                return;
+            }
+            if (rt_device_open(dev, RT_DEVICE_FLAG_RDWR) != RT_EOK)
+            {
+                LOG_E("open device failed!");
+                return;
+            }
+            rt_device_control(dev, RT_SENSOR_CTRL_GET_ID, &reg);
+            LOG_I("device id: 0x%x!", reg);
+
+        }
+        else if (dev == RT_NULL)
+        {
+            LOG_W("Please probe sensor first!");
+            return ;
+        }
+        else if (!strcmp(argv[1], "sr"))
+        {
+            rt_device_control(dev, RT_SENSOR_CTRL_SET_RANGE, (void *)atoi(argv[2]));
+        }
+        else if (!strcmp(argv[1], "sm"))
+        {
+            rt_device_control(dev, RT_SENSOR_CTRL_SET_MODE, (void *)atoi(argv[2]));
+        }
+        else if (!strcmp(argv[1], "sp"))
+        {
+            rt_device_control(dev, RT_SENSOR_CTRL_SET_POWER, (void *)atoi(argv[2]));
+        }
+        else if (!strcmp(argv[1], "sodr"))
+        {
+            rt_device_control(dev, RT_SENSOR_CTRL_SET_ODR, (void *)atoi(argv[2]));
+        }
+        else if (!strcmp(argv[1], "sage"))
+        {
+            rt_device_control(dev, RT_SENSOR_CTRL_SET_MAX_AGE, (void *)atoi(argv[2]));
+        }
+        else if (!strcmp(argv[1], "sidle"))
+        {
+            rt_device_control(dev, RT_SENSOR_CTRL_SET_IDLE_TIMEOUT, (void *)atoi(argv[2]));
+        }
+        else if (!strcmp(argv[1], "sspeed"))
+        {
+            rt_device_control(dev, RT_SENSOR_CTRL_SET_REPLAY_SPEED, (void *)atoi(argv[2]));
+        }
+        else
+        {
+            LOG_W("Unknown command, please enter 'sensor' get help information!");
+        }
+    }
+    else
+    {
+        LOG_W("Unknown command, please enter 'sensor' get help information!");
+    }
+}
+#ifdef FINSH_USING_MSH
+MSH_CMD_EXPORT(sensor, sensor test function);
+#endif
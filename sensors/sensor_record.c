@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include "sensor.h"
+#include <rthw.h>
+
+#define DBG_TAG  "sensor.record"
+#define DBG_LVL  DBG_INFO
+#include <rtdbg.h>
+
+#ifdef RT_SENSOR_USING_RECORD
+
+#ifndef RT_SENSOR_RECORD_BUF_SIZE
+#define RT_SENSOR_RECORD_BUF_SIZE   64      /* Records gathered before a write to the sink */
+#endif
+
+/* Sensor recorder correlation function */
+
+/*
+ * The readers of all sensors append to one buffer under the recorder lock;
+ * the sink is only called when the buffer is full or on stop, so a read
+ * pays for a file write once every RT_SENSOR_RECORD_BUF_SIZE samples.
+ */
+static struct
+{
+    rt_sensor_record_write_t        write;      /* The sink, RT_NULL when not recording */
+    void                           *user_data;
+    rt_mutex_t                      lock;
+    struct rt_sensor_sample_stream  stream;
+    struct rt_sensor_sample         buf[RT_SENSOR_RECORD_BUF_SIZE];
+    rt_uint16_t                     num;        /* Records in buf */
+    rt_uint32_t                     records;    /* Records written */
+    rt_uint32_t                     drops;      /* Samples not recorded, 3-axis types or a failed write */
+} sensor_recorder;
+
+static void sensor_record_flush(void)
+{
+    rt_size_t size = sensor_recorder.num * sizeof(struct rt_sensor_sample);
+
+    if (sensor_recorder.num == 0)
+    {
+        return;
+    }
+
+    if (sensor_recorder.write(sensor_recorder.buf, size, sensor_recorder.user_data) == size)
+    {
+        sensor_recorder.records += sensor_recorder.num;
+    }
+    else
+    {
+        sensor_recorder.drops += sensor_recorder.num;
+    }
+    sensor_recorder.num = 0;
+}
+
+/**
+ * This function starts recording the samples returned by rt_device_read()
+ * of every sensor.
+ *
+ * @param write the sink the log is written to
+ * @param user_data passed to the sink
+ *
+ * @return the operation status, RT_EOK on OK, -RT_EBUSY if already recording.
+ */
+rt_err_t rt_sensor_record_start(rt_sensor_record_write_t write, void *user_data)
+{
+    struct rt_sensor_record_header header;
+    rt_err_t result = RT_EOK;
+    rt_base_t level;
+
+    RT_ASSERT(write != RT_NULL);
+
+    if (sensor_recorder.lock == RT_NULL)
+    {
+        rt_mutex_t lock = rt_mutex_create("sen_rec", RT_IPC_FLAG_FIFO);
+
+        if (lock == RT_NULL)
+        {
+            return -RT_ENOMEM;
+        }
+        level = rt_hw_interrupt_disable();
+        if (sensor_recorder.lock == RT_NULL)
+        {
+            sensor_recorder.lock = lock;
+            lock = RT_NULL;
+        }
+        rt_hw_interrupt_enable(level);
+        if (lock != RT_NULL)
+        {
+            rt_mutex_delete(lock);
+        }
+    }
+
+    rt_mutex_take(sensor_recorder.lock, RT_WAITING_FOREVER);
+    if (sensor_recorder.write != RT_NULL)
+    {
+        result = -RT_EBUSY;
+        goto __exit;
+    }
+
+    rt_memset(&header, 0, sizeof(header));
+    header.magic = RT_SENSOR_RECORD_MAGIC;
+    header.sample_size = sizeof(struct rt_sensor_sample);
+    header.base_us = rt_sensor_get_ts_us();
+    if (write(&header, sizeof(header), user_data) != sizeof(header))
+    {
+        result = -RT_EIO;
+        goto __exit;
+    }
+
+    rt_sensor_sample_stream_init(&sensor_recorder.stream, header.base_us);
+    sensor_recorder.user_data = user_data;
+    sensor_recorder.num = 0;
+    sensor_recorder.records = 0;
+    sensor_recorder.drops = 0;
+    sensor_recorder.write = write;
+
+__exit:
+    rt_mutex_release(sensor_recorder.lock);
+    return result;
+}
+
+/**
+ * This function writes out the buffered records and stops recording.
+ *
+ * @return the operation status, RT_EOK on OK, -RT_ERROR if not recording.
+ */
+rt_err_t rt_sensor_record_stop(void)
+{
+    if (sensor_recorder.lock == RT_NULL)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(sensor_recorder.lock, RT_WAITING_FOREVER);
+    if (sensor_recorder.write == RT_NULL)
+    {
+        rt_mutex_release(sensor_recorder.lock);
+        return -RT_ERROR;
+    }
+    sensor_record_flush();
+    sensor_recorder.write = RT_NULL;
+    rt_mutex_release(sensor_recorder.lock);
+
+    LOG_I("recorded %d samples, %d dropped", sensor_recorder.records, sensor_recorder.drops);
+
+    return RT_EOK;
+}
+
+/* Called by rt_sensor_read() with the samples it returns */
+void rt_sensor_record(rt_sensor_t sensor, const struct rt_sensor_data *data, rt_size_t num)
+{
+    struct rt_sensor_data rec;
+    rt_size_t i;
+
+    /* Unlocked test, a read racing with start or stop may miss the log */
+    if (sensor_recorder.write == RT_NULL || num == 0)
+    {
+        return;
+    }
+
+    rt_mutex_take(sensor_recorder.lock, RT_WAITING_FOREVER);
+    if (sensor_recorder.write != RT_NULL)
+    {
+        for (i = 0; i < num; i++)
+        {
+            /* Not every driver fills in the type, the channel is that of the sensor */
+            rec = data[i];
+            rec.type = sensor->info.type;
+            if (rt_sensor_sample_pack(&sensor_recorder.stream, &rec,
+                                      &sensor_recorder.buf[sensor_recorder.num]) != RT_EOK)
+            {
+                sensor_recorder.drops++;
+                continue;
+            }
+            if (++sensor_recorder.num == RT_SENSOR_RECORD_BUF_SIZE)
+            {
+                sensor_record_flush();
+            }
+        }
+    }
+    rt_mutex_release(sensor_recorder.lock);
+}
+
+/* Sensor replay correlation function */
+
+/*
+ * A replay sensor plays the records of its type from a log. Record i is
+ * due at anchor_play_us + (t_i - anchor_rec_us) / speed; the anchors are
+ * set by the first fetch and by every speed change.
+ */
+struct sensor_replay
+{
+    rt_sensor_record_read_t         read;
+    void                           *user_data;
+    rt_uint16_t                     speed;          /* 0: one record per fetch */
+
+    struct rt_sensor_sample_stream  stream;
+    rt_uint64_t                     anchor_rec_us;  /* A time on the log */
+    rt_uint64_t                     anchor_play_us; /* When it plays, 0 until the first fetch */
+
+    struct rt_sensor_data           next;           /* Read-ahead record of the type */
+    rt_bool_t                       has_next;
+    struct rt_sensor_data           cur;            /* The record served last */
+    rt_bool_t                       has_cur;
+};
+
+/* Read ahead to the next record of the sensor type, the others only move the stream */
+static void sensor_replay_load(rt_sensor_t sensor, struct sensor_replay *rp)
+{
+    struct rt_sensor_sample sample;
+
+    rp->has_next = RT_FALSE;
+    while (rp->read(&sample, sizeof(sample), rp->user_data) == sizeof(sample))
+    {
+        rt_sensor_sample_unpack(&rp->stream, &sample, &rp->next);
+        if (rp->next.type == sensor->info.type)
+        {
+            rp->has_next = RT_TRUE;
+            break;
+        }
+    }
+}
+
+static rt_uint64_t sensor_replay_due(struct sensor_replay *rp, rt_uint64_t rec_us)
+{
+    if (rec_us <= rp->anchor_rec_us)
+    {
+        return rp->anchor_play_us;
+    }
+
+    return rp->anchor_play_us + (rec_us - rp->anchor_rec_us) / rp->speed;
+}
+
+/* Serve the next record, stamped with 'ts_us' */
+static void sensor_replay_take(rt_sensor_t sensor, struct sensor_replay *rp, struct rt_sensor_data *data, rt_uint64_t ts_us)
+{
+    rp->cur = rp->next;
+    rp->has_cur = RT_TRUE;
+    sensor_replay_load(sensor, rp);
+
+    *data = rp->cur;
+    data->timestamp_us = ts_us;
+    data->timestamp = (rt_uint32_t)(ts_us * RT_TICK_PER_SECOND / 1000000);
+}
+
+static rt_size_t sensor_replay_fetch_data(struct rt_sensor_device *sensor, void *buf, rt_size_t len)
+{
+    struct sensor_replay *rp = (struct sensor_replay *)sensor->config.intf.user_data;
+    struct rt_sensor_data *data = (struct rt_sensor_data *)buf;
+    rt_uint64_t now = rt_sensor_get_ts_us();
+    rt_uint64_t due;
+    rt_size_t num = 0;
+
+    if (rp->speed == 0)
+    {
+        /* Step mode, each fetch plays the next records */
+        while (num < len && rp->has_next)
+        {
+            sensor_replay_take(sensor, rp, &data[num++], now);
+        }
+        return num;
+    }
+
+    if (rp->anchor_play_us == 0)
+    {
+        /* The first record plays at the first fetch */
+        if (rp->has_next)
+        {
+            rp->anchor_rec_us = rp->next.timestamp_us;
+        }
+        rp->anchor_play_us = now;
+    }
+
+    while (rp->has_next && (due = sensor_replay_due(rp, rp->next.timestamp_us)) <= now)
+    {
+        /* A single sample read gets the newest due record, a longer one each in turn */
+        if (len == 1)
+        {
+            sensor_replay_take(sensor, rp, data, due);
+            num = 1;
+        }
+        else if (num < len)
+        {
+            sensor_replay_take(sensor, rp, &data[num++], due);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (num == 0 && len == 1 && rp->has_cur)
+    {
+        /* Nothing new, the value holds like on a real sensor */
+        *data = rp->cur;
+        data->timestamp_us = now;
+        data->timestamp = (rt_uint32_t)(now * RT_TICK_PER_SECOND / 1000000);
+        num = 1;
+    }
+
+    return num;
+}
+
+static rt_err_t sensor_replay_control(struct rt_sensor_device *sensor, int cmd, void *args)
+{
+    struct sensor_replay *rp = (struct sensor_replay *)sensor->config.intf.user_data;
+    rt_uint64_t now;
+
+    switch (cmd)
+    {
+    case RT_SENSOR_CTRL_GET_ID:
+        if (args)
+        {
+            *(rt_uint8_t *)args = 0;
+        }
+        break;
+    case RT_SENSOR_CTRL_SET_REPLAY_SPEED:
+        now = rt_sensor_get_ts_us();
+
+        /* Go on from the current position of the log at the new speed */
+        if (rp->speed != 0 && rp->anchor_play_us != 0)
+        {
+            rp->anchor_rec_us += (now - rp->anchor_play_us) * rp->speed;
+            rp->anchor_play_us = now;
+        }
+        else if (rp->has_next)
+        {
+            rp->anchor_rec_us = rp->next.timestamp_us;
+            rp->anchor_play_us = now;
+        }
+        rp->speed = (rt_base_t)args & 0xFFFF;
+        break;
+    case RT_SENSOR_CTRL_SET_POWER:
+        /* A log keeps playing, it cannot be put to sleep */
+        if (((rt_base_t)args & 0xFF) != RT_SENSOR_POWER_NORMAL)
+        {
+            return -RT_ENOSYS;
+        }
+        break;
+    default:
+        /* Mode, range and rate have nothing to act on */
+        break;
+    }
+
+    return RT_EOK;
+}
+
+static struct rt_sensor_ops sensor_replay_ops =
+{
+    sensor_replay_fetch_data,
+    sensor_replay_control
+};
+
+/**
+ * This function registers a sensor that plays the records of one type
+ * from a log made by rt_sensor_record_start().
+ *
+ * @param name the name of the sensor, prefixed with the type like any sensor
+ * @param type the sensor type to play, RT_SENSOR_CLASS_xxx
+ * @param read the source of the log, read from the start
+ * @param user_data passed to the source
+ * @param speed play var times faster than recorded, 0 = one record per fetch
+ *
+ * @return the operation status, RT_EOK on OK.
+ */
+int rt_hw_sensor_replay_init(const char *name, rt_uint8_t type, rt_sensor_record_read_t read, void *user_data,
+                             rt_uint16_t speed)
+{
+    struct rt_sensor_record_header header;
+    struct sensor_replay *rp;
+    rt_sensor_t sensor;
+    int result;
+
+    RT_ASSERT(read != RT_NULL);
+
+    if (read(&header, sizeof(header), user_data) != sizeof(header) ||
+        header.magic != RT_SENSOR_RECORD_MAGIC || header.sample_size != sizeof(struct rt_sensor_sample))
+    {
+        LOG_E("'%s' is not a sensor log of this build", name);
+        return -RT_EINVAL;
+    }
+
+    sensor = rt_calloc(1, sizeof(struct rt_sensor_device));
+    rp = rt_calloc(1, sizeof(struct sensor_replay));
+    if (sensor == RT_NULL || rp == RT_NULL)
+    {
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+
+    rp->read = read;
+    rp->user_data = user_data;
+    rp->speed = speed;
+    rt_sensor_sample_stream_init(&rp->stream, header.base_us);
+    rp->anchor_rec_us = header.base_us;
+
+    sensor->info.type       = type;
+    sensor->info.vendor     = RT_SENSOR_VENDOR_UNKNOWN;
+    sensor->info.model      = "replay";
+    sensor->info.unit       = RT_SENSOR_UNIT_NONE;
+    sensor->info.intf_type  = 0;
+    sensor->info.range_max  = 0x7FFFFFFF;
+    sensor->info.range_min  = -0x7FFFFFFF - 1;
+    sensor->info.period_min = 0;
+    sensor->config.intf.user_data = rp;
+    sensor->config.irq_pin.pin = RT_PIN_NONE;
+    sensor->config.mode = RT_SENSOR_MODE_POLLING;
+    sensor->ops = &sensor_replay_ops;
+
+    sensor_replay_load(sensor, rp);
+    if (!rp->has_next)
+    {
+        LOG_W("no record of type %d for '%s'", type, name);
+    }
+
+    result = rt_hw_sensor_register(sensor, name, RT_DEVICE_FLAG_RDONLY, RT_NULL);
+    if (result != RT_EOK)
+    {
+        LOG_E("device register err code: %d", result);
+        goto __exit;
+    }
+
+    return RT_EOK;
+
+__exit:
+    rt_free(sensor);
+    rt_free(rp);
+    return result;
+}
+
+#endif /* RT_SENSOR_USING_RECORD */
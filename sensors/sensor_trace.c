@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2006-2018, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     RT-Thread    first version
+ */
+
+#include "sensor.h"
+#include <rthw.h>
+
+#ifdef RT_SENSOR_USING_TRACE
+
+#ifndef RT_SENSOR_TRACE_DEPTH
+#define RT_SENSOR_TRACE_DEPTH    256    /* Number of events kept, must be a power of 2 */
+#endif
+
+#if (RT_SENSOR_TRACE_DEPTH & (RT_SENSOR_TRACE_DEPTH - 1)) != 0
+#error "RT_SENSOR_TRACE_DEPTH must be a power of 2"
+#endif
+
+#if defined(__GNUC__)
+#define SENSOR_TRACE_BARRIER()    __asm__ volatile ("" : : : "memory")
+#else
+#define SENSOR_TRACE_BARRIER()
+#endif
+
+struct sensor_trace_event
+{
+    rt_uint64_t          ts_us;     /* rt_sensor_get_ts_us() of the event */
+    rt_sensor_t          sensor;    /* The sensor, RT_NULL if none */
+    rt_thread_t          thread;    /* The recording thread, RT_NULL in an ISR */
+    rt_uint32_t          arg;       /* Event argument, see RT_SENSOR_TRACE_xxx */
+    volatile rt_uint8_t  event;     /* RT_SENSOR_TRACE_NONE while the slot is written */
+};
+
+/*
+ * Writers from threads and ISRs only contend on the slot counter, which is
+ * bumped atomically. The oldest events are overwritten once the ring wraps.
+ */
+static struct sensor_trace_event sensor_trace_ring[RT_SENSOR_TRACE_DEPTH];
+static volatile rt_uint32_t sensor_trace_in = 0;
+static volatile rt_uint8_t  sensor_trace_paused = 0;
+
+static const char *const sensor_trace_name[RT_SENSOR_TRACE_MAX] =
+{
+    "none", "open", "close", "read_begin", "read_end", "fetch_begin",
+    "fetch_end", "irq", "rx_indicate", "lock_begin", "lock_end"
+};
+
+void rt_sensor_trace(rt_uint8_t event, rt_sensor_t sensor, rt_uint32_t arg)
+{
+    struct sensor_trace_event *e;
+    rt_uint32_t idx;
+
+    if (sensor_trace_paused)
+    {
+        return;
+    }
+
+#if defined(__GNUC__)
+    idx = __sync_fetch_and_add(&sensor_trace_in, 1);
+#else
+    {
+        rt_base_t level = rt_hw_interrupt_disable();
+        idx = sensor_trace_in++;
+        rt_hw_interrupt_enable(level);
+    }
+#endif
+
+    e = &sensor_trace_ring[idx & (RT_SENSOR_TRACE_DEPTH - 1)];
+    e->event = RT_SENSOR_TRACE_NONE;
+    SENSOR_TRACE_BARRIER();
+    e->ts_us = rt_sensor_get_ts_us();
+    e->sensor = sensor;
+    e->thread = rt_interrupt_get_nest() ? RT_NULL : rt_thread_self();
+    e->arg = arg;
+    SENSOR_TRACE_BARRIER();
+    e->event = event;
+}
+
+/* Name of a thread that is still alive, the event only holds its pointer */
+static const char *sensor_trace_thread_name(rt_thread_t thread)
+{
+    struct rt_object_information *info;
+    rt_list_t *node;
+
+    if (thread == RT_NULL)
+    {
+        return "irq";
+    }
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_list_for_each(node, &info->object_list)
+    {
+        if (rt_list_entry(node, struct rt_object, list) == (rt_object_t)thread)
+        {
+            return thread->name;
+        }
+    }
+
+    return "?";
+}
+
+/* Copy an object name that fills its RT_NAME_MAX bytes without a terminator */
+static void sensor_trace_copy_name(char *buf, const char *name)
+{
+    rt_strncpy(buf, name, RT_NAME_MAX);
+    buf[RT_NAME_MAX] = '\0';
+}
+
+/*
+ * Print the ring oldest first, one "trace,ts_us,tid,thread,event,sensor,arg"
+ * line per event. Recording pauses while the dump runs. Each event and the
+ * names it points to are copied with the scheduler locked, so a thread
+ * cannot exit under the name lookup, and printed after it is unlocked.
+ */
+void rt_sensor_trace_dump(void)
+{
+    struct sensor_trace_event ev;
+    char thread_name[RT_NAME_MAX + 1];
+    char sensor_name[RT_NAME_MAX + 1];
+    rt_uint32_t in, idx, num;
+
+    sensor_trace_paused = 1;
+    in = sensor_trace_in;
+    num = in < RT_SENSOR_TRACE_DEPTH ? in : RT_SENSOR_TRACE_DEPTH;
+
+    rt_kprintf("trace,begin,%u,%u\n", num, in - num);
+
+    for (idx = in - num; idx != in; idx++)
+    {
+        rt_enter_critical();
+        ev = sensor_trace_ring[idx & (RT_SENSOR_TRACE_DEPTH - 1)];
+        if (ev.event != RT_SENSOR_TRACE_NONE && ev.event < RT_SENSOR_TRACE_MAX)
+        {
+            sensor_trace_copy_name(thread_name, sensor_trace_thread_name(ev.thread));
+            sensor_trace_copy_name(sensor_name, ev.sensor ? ev.sensor->parent.parent.name : "-");
+        }
+        rt_exit_critical();
+
+        if (ev.event == RT_SENSOR_TRACE_NONE || ev.event >= RT_SENSOR_TRACE_MAX)
+        {
+            continue;
+        }
+
+        rt_kprintf("trace,%u%06u,%p,%s,%s,%s,%u\n",
+                   (rt_uint32_t)(ev.ts_us / 1000000), (rt_uint32_t)(ev.ts_us % 1000000), ev.thread,
+                   thread_name, sensor_trace_name[ev.event], sensor_name, ev.arg);
+    }
+
+    rt_kprintf("trace,end\n");
+    sensor_trace_paused = 0;
+}
+
+void rt_sensor_trace_clear(void)
+{
+    rt_uint32_t i;
+
+    sensor_trace_paused = 1;
+    for (i = 0; i < RT_SENSOR_TRACE_DEPTH; i++)
+    {
+        sensor_trace_ring[i].event = RT_SENSOR_TRACE_NONE;
+    }
+    sensor_trace_in = 0;
+    sensor_trace_paused = 0;
+}
+
+#endif /* RT_SENSOR_USING_TRACE */
@@ -0,0 +1,75 @@
+# Copyright (c) 2006-2018, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Convert the output of "sensor trace" captured from the console into the
+# Chrome trace event format. Open the result in chrome://tracing or
+# https://ui.perfetto.dev.
+#
+#   python3 sensor_trace2json.py console.log > trace.json
+#
+
+import json
+import sys
+
+SPANS = {
+    'read_begin':  ('B', 'read'),
+    'read_end':    ('E', 'read'),
+    'fetch_begin': ('B', 'fetch'),
+    'fetch_end':   ('E', 'fetch'),
+    'lock_begin':  ('B', 'lock wait'),
+    'lock_end':    ('E', 'lock wait'),
+}
+
+
+def parse(lines):
+    """Yield (ts_us, tid, thread, event, sensor, arg) of every trace line."""
+    for line in lines:
+        pos = line.find('trace,')
+        if pos < 0:
+            continue
+        fields = line[pos:].strip().split(',')
+        if len(fields) != 7:
+            continue
+        _, ts, tid, thread, event, sensor, arg = fields
+        yield int(ts), tid, thread, event, sensor, int(arg)
+
+
+def convert(records):
+    events = []
+    tids = {}
+    base = None
+
+    for ts, tid, thread, event, sensor, arg in records:
+        if base is None:
+            base = ts
+        if tid not in tids:
+            tids[tid] = len(tids) + 1
+            events.append({'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': tids[tid],
+                           'args': {'name': thread}})
+
+        ev = {'ts': ts - base, 'pid': 1, 'tid': tids[tid], 'args': {'sensor': sensor, 'arg': arg}}
+        if event in SPANS:
+            ev['ph'], name = SPANS[event]
+            ev['name'] = '%s %s' % (name, sensor)
+        else:
+            ev['ph'] = 'i'
+            ev['s'] = 't'
+            ev['name'] = '%s %s' % (event, sensor)
+        events.append(ev)
+
+    return {'traceEvents': events, 'displayTimeUnit': 'ms'}
+
+
+def main():
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], errors='replace') as f:
+            trace = convert(parse(f))
+    else:
+        trace = convert(parse(sys.stdin))
+    json.dump(trace, sys.stdout, indent=1)
+    sys.stdout.write('\n')
+
+
+if __name__ == '__main__':
+    main()